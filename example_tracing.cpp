@@ -1,8 +1,10 @@
 // SPDX-License-Identifier: MIT
 
+#include "jerryct/telemetry/async_span.h"
 #include "jerryct/telemetry/chrome_trace_event_exporter.h"
 #include "jerryct/telemetry/span.h"
 #include <thread>
+#include <utility>
 
 namespace {
 
@@ -12,9 +14,14 @@ void Async() {
   if (t.joinable()) {
     t.join();
   }
-  t = std::thread{[]() {
+  // The request starts here and completes on the worker thread.
+  jerryct::telemetry::AsyncSpan request{jerryct::telemetry::Tracer(), "Request"};
+  jerryct::telemetry::Flow flow{jerryct::telemetry::Tracer(), "Handover"};
+  t = std::thread{[request = std::move(request), flow]() mutable {
     jerryct::telemetry::Span _{jerryct::telemetry::Tracer(), "Async"};
+    flow.End();
     std::this_thread::sleep_for(std::chrono::milliseconds{42});
+    request.End();
   }};
 }
 
@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/async_span.h"
+#include <utility>
+
+namespace jerryct {
+namespace telemetry {
+
+namespace {
+
+std::uint32_t Begin(TracerImpl &t, const Phase phase, const std::uint32_t name) {
+  if (!t.Sampled(name)) {
+    return 0U;
+  }
+  const std::uint32_t id{t.NewId()};
+  t.PerThreadEvents()->Emplace(Event{phase, name & 0xFFFFFFU, id, t.Now()});
+  return id;
+}
+
+void Finish(TracerImpl &t, const Phase phase, const std::uint32_t name, const std::uint32_t id) {
+  t.PerThreadEvents()->Emplace(Event{phase, name & 0xFFFFFFU, id, t.Now()});
+}
+
+} // namespace
+
+AsyncSpan::AsyncSpan(TracerImpl &t, const jerryct::string_view name) : AsyncSpan{t, t.RegisterName(name)} {}
+
+AsyncSpan::AsyncSpan(TracerImpl &t, const std::uint32_t name)
+    : t_{&t}, name_{name}, id_{Begin(t, Phase::async_begin, name)} {}
+
+AsyncSpan::AsyncSpan(AsyncSpan &&other) noexcept
+    : t_{other.t_}, name_{other.name_}, id_{std::exchange(other.id_, 0U)} {}
+
+AsyncSpan &AsyncSpan::operator=(AsyncSpan &&other) noexcept {
+  if (this != &other) {
+    End();
+    t_ = other.t_;
+    name_ = other.name_;
+    id_ = std::exchange(other.id_, 0U);
+  }
+  return *this;
+}
+
+AsyncSpan::~AsyncSpan() noexcept { End(); }
+
+void AsyncSpan::End() noexcept {
+  if (id_ != 0U) {
+    Finish(*t_, Phase::async_end, name_, std::exchange(id_, 0U));
+  }
+}
+
+Flow::Flow(TracerImpl &t, const jerryct::string_view name) : Flow{t, t.RegisterName(name)} {}
+
+Flow::Flow(TracerImpl &t, const std::uint32_t name) : t_{&t}, name_{name}, id_{Begin(t, Phase::flow_start, name)} {}
+
+void Flow::End() noexcept {
+  if (id_ != 0U) {
+    Finish(*t_, Phase::flow_end, name_, std::exchange(id_, 0U));
+  }
+}
+
+} // namespace telemetry
+} // namespace jerryct
@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: MIT
+
+#ifndef JERRYCT_TELEMETRY_ASYNC_SPAN_H
+#define JERRYCT_TELEMETRY_ASYNC_SPAN_H
+
+#include "jerryct/string_view.h"
+#include "jerryct/telemetry/tracer.h"
+#include <cstdint>
+
+namespace jerryct {
+namespace telemetry {
+
+// A span with an explicit id which begins on the constructing thread and ends on whichever thread calls End(), e.g. a
+// request hopping between thread pools. Ends on destruction if End() was not called before.
+class AsyncSpan final {
+public:
+  AsyncSpan(TracerImpl &t, const jerryct::string_view name);
+  AsyncSpan(TracerImpl &t, const std::uint32_t name);
+  AsyncSpan(const AsyncSpan &) = delete;
+  AsyncSpan(AsyncSpan &&other) noexcept;
+  AsyncSpan &operator=(const AsyncSpan &) = delete;
+  AsyncSpan &operator=(AsyncSpan &&other) noexcept;
+  ~AsyncSpan() noexcept;
+
+  void End() noexcept;
+
+  // 0 if the span is not sampled or already ended.
+  std::uint32_t Id() const noexcept { return id_; }
+
+private:
+  TracerImpl *t_;
+  std::uint32_t name_;
+  std::uint32_t id_;
+};
+
+// Links the span enclosing the construction of a Flow on a producer thread to the span enclosing End() on a consumer
+// thread. Copyable, so it can travel with the work item.
+class Flow final {
+public:
+  Flow(TracerImpl &t, const jerryct::string_view name);
+  Flow(TracerImpl &t, const std::uint32_t name);
+
+  // Links the flow; later calls on the same object have no effect.
+  void End() noexcept;
+
+  // 0 if the flow is not sampled or already ended.
+  std::uint32_t Id() const noexcept { return id_; }
+
+private:
+  TracerImpl *t_;
+  std::uint32_t name_;
+  std::uint32_t id_;
+};
+
+} // namespace telemetry
+} // namespace jerryct
+
+#endif // JERRYCT_TELEMETRY_ASYNC_SPAN_H
@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/async_span.h"
+#include "jerryct/telemetry/span.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace jerryct {
+namespace telemetry {
+namespace {
+
+using Record = std::tuple<std::int32_t, std::string, Phase, std::uint32_t>;
+
+std::vector<Record> Export(TracerImpl &tracer) {
+  std::vector<Record> records{};
+  tracer.Export([&records](const std::int32_t tid, const std::uint64_t /*unused*/, const Segments<Event> &data,
+                           const NameTable &names, const TimeBase & /*unused*/) {
+    for (const Event &e : data) {
+      if ((e.phase != Phase::begin) && (e.phase != Phase::end)) {
+        records.emplace_back(tid, std::string{names.Get(e.name).data(), names.Get(e.name).size()}, e.phase,
+                             e.duration);
+      }
+    }
+  });
+  return records;
+}
+
+TEST(AsyncSpanTest, WhenEndedOnAnotherThread_ExpectBeginAndEndWithSameId) {
+  TracerImpl tracer{};
+  std::uint32_t id{};
+
+  std::thread t1{[&tracer, &id]() {
+    AsyncSpan request{tracer, "request"};
+    id = request.Id();
+    std::thread t2{[request = std::move(request)]() mutable { request.End(); }};
+    t2.join();
+  }};
+  t1.join();
+
+  std::vector<Record> records{Export(tracer)};
+  std::sort(records.begin(), records.end(),
+            [](const Record &lhs, const Record &rhs) { return std::get<2>(lhs) < std::get<2>(rhs); });
+  ASSERT_EQ(2U, records.size());
+
+  EXPECT_NE(0U, id);
+  EXPECT_NE(std::get<0>(records[0U]), std::get<0>(records[1U]));
+  EXPECT_EQ("request", std::get<1>(records[0U]));
+  EXPECT_EQ(Phase::async_begin, std::get<2>(records[0U]));
+  EXPECT_EQ(id, std::get<3>(records[0U]));
+  EXPECT_EQ("request", std::get<1>(records[1U]));
+  EXPECT_EQ(Phase::async_end, std::get<2>(records[1U]));
+  EXPECT_EQ(id, std::get<3>(records[1U]));
+}
+
+TEST(AsyncSpanTest, WhenEndedTwice_ExpectSingleEnd) {
+  TracerImpl tracer{};
+
+  std::thread t{[&tracer]() {
+    AsyncSpan a{tracer, "a"};
+    AsyncSpan b{tracer, "b"};
+    a.End();
+    a.End();
+    EXPECT_EQ(0U, a.Id());
+    EXPECT_NE(0U, b.Id());
+  }};
+  t.join();
+
+  const std::vector<Record> records{Export(tracer)};
+  ASSERT_EQ(4U, records.size());
+  EXPECT_EQ(Phase::async_end, std::get<2>(records[2U]));
+  EXPECT_EQ("a", std::get<1>(records[2U]));
+  EXPECT_EQ(Phase::async_end, std::get<2>(records[3U]));
+  EXPECT_EQ("b", std::get<1>(records[3U]));
+  EXPECT_NE(std::get<3>(records[2U]), std::get<3>(records[3U]));
+}
+
+TEST(AsyncSpanTest, WhenNotSampled_ExpectNoEvents) {
+  TracerImpl tracer{};
+  tracer.SetSampling(SamplingRule{"*", 0.0});
+
+  std::thread t{[&tracer]() {
+    AsyncSpan a{tracer, "a"};
+    Flow f{tracer, "f"};
+    f.End();
+  }};
+  t.join();
+
+  EXPECT_TRUE(Export(tracer).empty());
+}
+
+TEST(FlowTest, WhenEndedOnConsumer_ExpectStartAndEndWithSameId) {
+  TracerImpl tracer{};
+
+  std::thread t1{[&tracer]() {
+    Span producer{tracer, "produce"};
+    Flow flow{tracer, "handover"};
+    std::thread t2{[&tracer, flow]() mutable {
+      Span consumer{tracer, "consume"};
+      flow.End();
+      flow.End();
+    }};
+    t2.join();
+  }};
+  t1.join();
+
+  std::vector<Record> records{Export(tracer)};
+  std::sort(records.begin(), records.end(),
+            [](const Record &lhs, const Record &rhs) { return std::get<2>(lhs) < std::get<2>(rhs); });
+  ASSERT_EQ(2U, records.size());
+  EXPECT_EQ(Phase::flow_start, std::get<2>(records[0U]));
+  EXPECT_EQ(Phase::flow_end, std::get<2>(records[1U]));
+  EXPECT_EQ(std::get<3>(records[0U]), std::get<3>(records[1U]));
+  EXPECT_NE(std::get<0>(records[0U]), std::get<0>(records[1U]));
+}
+
+} // namespace
+} // namespace telemetry
+} // namespace jerryct
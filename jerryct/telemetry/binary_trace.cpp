@@ -0,0 +1,223 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/binary_trace.h"
+#include "jerryct/telemetry/varint.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+namespace jerryct {
+namespace telemetry {
+
+namespace {
+
+constexpr char magic[8]{'J', 'C', 'T', 'R', 'A', 'C', 'E', '1'};
+constexpr std::uint32_t unknown_name{std::numeric_limits<std::uint32_t>::max()};
+
+void PutPhase(const Phase phase, std::vector<std::uint8_t> &buf) { buf.push_back(static_cast<std::uint8_t>(phase)); }
+
+} // namespace
+
+BinaryTraceExporter::BinaryTraceExporter(const std::string &filename, const FileSinkOptions &options)
+    : f_{filename, options} {
+  f_.Write(magic, sizeof(magic));
+}
+
+void BinaryTraceExporter::operator()(const std::int32_t tid, const std::uint64_t losts, const Segments<Event> &events,
+                                     const NameTable &names, const TimeBase &time_base) {
+  if (!time_base_ || (time_base_->Ticks() != time_base.Ticks()) || (time_base_->Time() != time_base.Time()) ||
+      (time_base_->NsPerTick() != time_base.NsPerTick())) {
+    time_base_.reset(new TimeBase{time_base});
+    const double ns_per_tick{time_base.NsPerTick()};
+    std::uint8_t bytes[sizeof(ns_per_tick)];
+    std::memcpy(bytes, &ns_per_tick, sizeof(ns_per_tick));
+    buf_.push_back('T');
+    PutZigzag(time_base.Ticks(), buf_);
+    PutZigzag(std::chrono::duration_cast<std::chrono::nanoseconds>(time_base.Time().time_since_epoch()).count(), buf_);
+    buf_.insert(buf_.end(), std::begin(bytes), std::end(bytes));
+  }
+
+  block_.clear();
+  std::int64_t last{0};
+  for (const Event &e : events) {
+    PutPhase(e.phase, block_);
+    switch (e.phase) {
+    case Phase::end:
+      PutZigzag(e.time_stamp - last, block_);
+      last = e.time_stamp;
+      break;
+    case Phase::begin:
+    case Phase::complete:
+    case Phase::async_begin:
+    case Phase::async_end:
+    case Phase::flow_start:
+    case Phase::flow_end:
+      WriteName(e.name, names);
+      PutVarint(e.name, block_);
+      PutZigzag(e.time_stamp - last, block_);
+      last = e.time_stamp;
+      if (e.phase != Phase::begin) {
+        PutVarint(e.duration, block_);
+      }
+      break;
+    case Phase::arg_int:
+    case Phase::arg_uint:
+    case Phase::arg_double:
+    case Phase::arg_string:
+      WriteName(e.name, names);
+      PutVarint(e.name, block_);
+      PutVarint(e.duration, block_);
+      PutZigzag(e.time_stamp, block_);
+      break;
+    }
+  }
+
+  buf_.push_back('B');
+  PutVarint(static_cast<std::uint64_t>(tid), buf_);
+  PutVarint(losts, buf_);
+  PutVarint(events.size(), buf_);
+  buf_.insert(buf_.end(), block_.begin(), block_.end());
+
+  f_.Write(buf_.data(), buf_.size());
+  buf_.clear();
+}
+
+void BinaryTraceExporter::WriteName(const std::uint32_t id, const NameTable &names) {
+  if (id >= written_.size()) {
+    written_.resize(id + 1U, false);
+  }
+  if (written_[id]) {
+    return;
+  }
+  written_[id] = true;
+
+  const string_view name{names.Get(id)};
+  buf_.push_back('N');
+  PutVarint(id, buf_);
+  PutVarint(name.size(), buf_);
+  buf_.insert(buf_.end(), name.begin(), name.end());
+}
+
+BinaryTraceReader::BinaryTraceReader(const std::string &filename) {
+  std::ifstream f{filename, std::ios::binary};
+  if (!f) {
+    throw std::runtime_error{"cannot open " + filename};
+  }
+  data_.assign(std::istreambuf_iterator<char>{f}, {});
+  if ((data_.size() < sizeof(magic)) || (std::memcmp(data_.data(), magic, sizeof(magic)) != 0)) {
+    throw std::runtime_error{filename + " is not a binary trace"};
+  }
+  names_.Register("");
+}
+
+bool BinaryTraceReader::NextBlock() {
+  while (pos_ < data_.size()) {
+    switch (Byte()) {
+    case 'T': {
+      const std::int64_t ticks{Zigzag()};
+      const std::chrono::nanoseconds time{Zigzag()};
+      if ((data_.size() - pos_) < sizeof(double)) {
+        throw std::runtime_error{"truncated binary trace"};
+      }
+      double ns_per_tick{};
+      std::memcpy(&ns_per_tick, &data_[pos_], sizeof(ns_per_tick));
+      pos_ += sizeof(ns_per_tick);
+      time_base_ = TimeBase{ticks, std::chrono::steady_clock::time_point{time}, ns_per_tick};
+    } break;
+    case 'N': {
+      const std::uint64_t id{Varint()};
+      const std::uint64_t size{Varint()};
+      if ((id >= NameTable::capacity) || ((data_.size() - pos_) < size)) {
+        throw std::runtime_error{"malformed name in binary trace"};
+      }
+      if (id >= ids_.size()) {
+        ids_.resize(id + 1U, unknown_name);
+      }
+      ids_[id] = names_.Register(string_view{reinterpret_cast<const char *>(&data_[pos_]), size});
+      pos_ += size;
+    } break;
+    case 'B': {
+      tid_ = static_cast<std::int32_t>(Varint());
+      losts_ = Varint();
+      const std::uint64_t count{Varint()};
+      events_.clear();
+      std::int64_t last{0};
+      for (std::uint64_t i{0U}; i < count; ++i) {
+        const Phase phase{static_cast<Phase>(Byte())};
+        Event e{phase, 0U, 0U, 0};
+        switch (phase) {
+        case Phase::end:
+          last += Zigzag();
+          e.time_stamp = last;
+          break;
+        case Phase::begin:
+        case Phase::complete:
+        case Phase::async_begin:
+        case Phase::async_end:
+        case Phase::flow_start:
+        case Phase::flow_end:
+          e.name = Name() & 0xFFFFFFU;
+          last += Zigzag();
+          e.time_stamp = last;
+          if (phase != Phase::begin) {
+            e.duration = static_cast<std::uint32_t>(Varint());
+          }
+          break;
+        case Phase::arg_int:
+        case Phase::arg_uint:
+        case Phase::arg_double:
+        case Phase::arg_string:
+          e.name = Name() & 0xFFFFFFU;
+          e.duration = static_cast<std::uint32_t>(Varint());
+          e.time_stamp = Zigzag();
+          break;
+        default:
+          throw std::runtime_error{"unknown event in binary trace"};
+        }
+        events_.push_back(e);
+      }
+      return true;
+    }
+    default:
+      throw std::runtime_error{"unknown record in binary trace"};
+    }
+  }
+  return false;
+}
+
+std::uint8_t BinaryTraceReader::Byte() {
+  if (pos_ >= data_.size()) {
+    throw std::runtime_error{"truncated binary trace"};
+  }
+  return data_[pos_++];
+}
+
+std::uint64_t BinaryTraceReader::Varint() {
+  std::uint64_t v{0U};
+  for (std::uint32_t shift{0U}; shift < 64U; shift += 7U) {
+    const std::uint8_t b{Byte()};
+    v |= std::uint64_t{b & 0x7FU} << shift;
+    if ((b & 0x80U) == 0U) {
+      return v;
+    }
+  }
+  throw std::runtime_error{"malformed varint in binary trace"};
+}
+
+std::int64_t BinaryTraceReader::Zigzag() {
+  const std::uint64_t v{Varint()};
+  return static_cast<std::int64_t>((v >> 1U) ^ (~(v & 1U) + 1U));
+}
+
+std::uint32_t BinaryTraceReader::Name() {
+  const std::uint64_t id{Varint()};
+  if ((id >= ids_.size()) || (ids_[id] == unknown_name)) {
+    throw std::runtime_error{"undefined name in binary trace"};
+  }
+  return ids_[id];
+}
+
+} // namespace telemetry
+} // namespace jerryct
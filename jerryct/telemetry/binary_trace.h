@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: MIT
+
+#ifndef JERRYCT_TELEMETRY_BINARY_TRACE_H
+#define JERRYCT_TELEMETRY_BINARY_TRACE_H
+
+#include "jerryct/telemetry/file_sink.h"
+#include "jerryct/telemetry/tracer.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace jerryct {
+namespace telemetry {
+
+// Compact trace file, typically a few bytes per event. The file starts with the magic JCTRACE1 followed by records,
+// each introduced by a tag byte:
+//
+//   'T' time base:  zigzag ticks, zigzag steady_clock nanoseconds, ns_per_tick as 8 bytes of a double
+//   'N' name:       varint id, varint size, bytes; written before the first block referring to the id
+//   'B' block:      varint tid, varint losts, varint number of events, events
+//
+// Each event is a phase byte followed by
+//
+//   begin:          varint name, zigzag time stamp delta
+//   end:            zigzag time stamp delta
+//   complete:       varint name, zigzag time stamp delta, varint duration
+//   async_, flow_:  varint name, zigzag time stamp delta, varint id
+//   arg_:           varint key, varint duration, zigzag time stamp (holding the value, hence not a delta)
+//
+// Time stamp deltas refer to the previous time stamp of the block; the first one to 0.
+class BinaryTraceExporter {
+public:
+  explicit BinaryTraceExporter(const std::string &filename, const FileSinkOptions &options = {});
+  BinaryTraceExporter(const BinaryTraceExporter &) = delete;
+  BinaryTraceExporter &operator=(const BinaryTraceExporter &) = delete;
+  BinaryTraceExporter(BinaryTraceExporter &&other) = default;
+  BinaryTraceExporter &operator=(BinaryTraceExporter &&other) = default;
+  ~BinaryTraceExporter() noexcept = default;
+
+  void operator()(const std::int32_t tid, const std::uint64_t losts, const Segments<Event> &events,
+                  const NameTable &names, const TimeBase &time_base);
+
+private:
+  void WriteName(const std::uint32_t id, const NameTable &names);
+
+  FileSink f_;
+  std::vector<std::uint8_t> buf_;
+  std::vector<std::uint8_t> block_;
+  std::vector<bool> written_;
+  std::unique_ptr<TimeBase> time_base_;
+};
+
+// Replays a file written by BinaryTraceExporter into any exporter of the tracer, e.g. to convert it offline into a
+// Chrome trace. Throws std::runtime_error if the file cannot be read or is malformed.
+class BinaryTraceReader {
+public:
+  explicit BinaryTraceReader(const std::string &filename);
+
+  // Calls func(tid, losts, events, names, time_base) per block. Names are renumbered but keep their text.
+  template <typename F> void Replay(F &&func) {
+    pos_ = 8U;
+    while (NextBlock()) {
+      func(tid_, losts_, Segments<Event>{Segment<Event>{events_.data(), events_.data() + events_.size()}},
+           static_cast<const NameTable &>(names_), static_cast<const TimeBase &>(time_base_));
+    }
+  }
+
+private:
+  bool NextBlock();
+  std::uint8_t Byte();
+  std::uint64_t Varint();
+  std::int64_t Zigzag();
+  std::uint32_t Name();
+
+  std::vector<std::uint8_t> data_;
+  std::size_t pos_{0U};
+  NameTable names_;
+  std::vector<std::uint32_t> ids_;
+  TimeBase time_base_;
+  std::int32_t tid_{0};
+  std::uint64_t losts_{0U};
+  std::vector<Event> events_;
+};
+
+} // namespace telemetry
+} // namespace jerryct
+
+#endif // JERRYCT_TELEMETRY_BINARY_TRACE_H
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/binary_trace.h"
+#include "jerryct/telemetry/span.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+void ExportBinaryTrace(benchmark::State &state) {
+  jerryct::telemetry::BinaryTraceExporter binary{"test.bin"};
+
+  auto name = std::string(64, 'c');
+  for (auto _ : state) {
+    jerryct::telemetry::Span s{jerryct::telemetry::Tracer(), name};
+    jerryct::telemetry::Tracer().Export(binary);
+  }
+}
+
+BENCHMARK(ExportBinaryTrace);
+
+} // namespace
@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/binary_trace.h"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace jerryct {
+namespace telemetry {
+namespace {
+
+using Record = std::tuple<std::int32_t, std::uint64_t, std::string, Phase, std::uint32_t, std::int64_t>;
+
+void Write(BinaryTraceExporter &exporter, const std::int32_t tid, const std::uint64_t losts,
+           const std::vector<Event> &events, const NameTable &names, const TimeBase &time_base) {
+  exporter(tid, losts, Segments<Event>{Segment<Event>{events.data(), events.data() + events.size()}}, names,
+           time_base);
+}
+
+std::vector<Record> Read(TimeBase *time_base = nullptr) {
+  std::vector<Record> records{};
+  BinaryTraceReader reader{"test.bin"};
+  reader.Replay([&records, time_base](const std::int32_t tid, const std::uint64_t losts, const Segments<Event> &events,
+                                      const NameTable &names, const TimeBase &t) {
+    for (const Event &e : events) {
+      records.emplace_back(tid, losts, std::string{names.Get(e.name).data(), names.Get(e.name).size()}, e.phase,
+                           e.duration, e.time_stamp);
+    }
+    if (time_base != nullptr) {
+      *time_base = t;
+    }
+  });
+  return records;
+}
+
+TEST(BinaryTraceTest, WhenReplayed_ExpectSameEvents) {
+  NameTable names{};
+  names.Register("");
+  names.Register("unused");
+  names.Register("main");
+  names.Register("bytes");
+
+  {
+    BinaryTraceExporter exporter{"test.bin"};
+    Write(exporter, 3, 0U,
+          {Event{Phase::begin, 2U, 0U, 1000000000000}, MakeArg(3U, std::uint64_t{4096U}),
+           Event{Phase::end, 0U, 0U, 1000000000500}, Event{Phase::complete, 2U, 42U, 999999999000},
+           Event{Phase::async_begin, 2U, 7U, 1000000001000}, MakeArg(3U, -2), MakeArg(3U, 0.5),
+           MakeArg(3U, string_view{"eu-1"})},
+          names, TimeBase{});
+    Write(exporter, 5, 17U, {Event{Phase::async_end, 2U, 7U, 1000000002000}}, names, TimeBase{});
+  }
+
+  const std::vector<Record> expected{
+      Record{3, 0U, "main", Phase::begin, 0U, 1000000000000},
+      Record{3, 0U, "bytes", Phase::arg_uint, 0U, 4096},
+      Record{3, 0U, "", Phase::end, 0U, 1000000000500},
+      Record{3, 0U, "main", Phase::complete, 42U, 999999999000},
+      Record{3, 0U, "main", Phase::async_begin, 7U, 1000000001000},
+      Record{3, 0U, "bytes", Phase::arg_int, 0U, -2},
+      Record{3, 0U, "bytes", Phase::arg_double, 0U, MakeArg(0U, 0.5).time_stamp},
+      Record{3, 0U, "bytes", Phase::arg_string, MakeArg(0U, string_view{"eu-1"}).duration, 0},
+      Record{5, 17U, "main", Phase::async_end, 7U, 1000000002000},
+  };
+  EXPECT_EQ(expected, Read());
+  std::remove("test.bin");
+}
+
+TEST(BinaryTraceTest, WhenTimeBaseGiven_ExpectSameTimeBase) {
+  NameTable names{};
+  names.Register("");
+  const TimeBase time_base{123, std::chrono::steady_clock::time_point{std::chrono::nanoseconds{456}}, 0.25};
+
+  {
+    BinaryTraceExporter exporter{"test.bin"};
+    Write(exporter, 0, 0U, {Event{Phase::end, 0U, 0U, 1}}, names, time_base);
+  }
+
+  TimeBase read{};
+  Read(&read);
+  EXPECT_EQ(123, read.Ticks());
+  EXPECT_EQ(456, read.Time().time_since_epoch().count());
+  EXPECT_DOUBLE_EQ(0.25, read.NsPerTick());
+  std::remove("test.bin");
+}
+
+TEST(BinaryTraceTest, WhenEventsRepeat_ExpectFewBytesPerEvent) {
+  NameTable names{};
+  names.Register("");
+  names.Register(std::string(64, 'c'));
+
+  std::vector<Event> events{};
+  for (std::int64_t i{0}; i < 1000; ++i) {
+    events.push_back(Event{Phase::begin, 1U, 0U, 1000000000000 + (i * 100)});
+    events.push_back(Event{Phase::end, 0U, 0U, 1000000000000 + (i * 100) + 50});
+  }
+  {
+    BinaryTraceExporter exporter{"test.bin"};
+    Write(exporter, 0, 0U, events, names, TimeBase{});
+  }
+
+  std::ifstream f{"test.bin", std::ios::binary | std::ios::ate};
+  EXPECT_GT(4U * events.size(), static_cast<std::size_t>(f.tellg()));
+  std::remove("test.bin");
+}
+
+TEST(BinaryTraceTest, WhenNotBinaryTrace_ExpectThrow) {
+  {
+    std::ofstream f{"test.bin"};
+    f << "[{}]";
+  }
+  EXPECT_THROW(BinaryTraceReader{"test.bin"}, std::runtime_error);
+  std::remove("test.bin");
+}
+
+} // namespace
+} // namespace telemetry
+} // namespace jerryct
@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/call_tree.h"
+#include <limits>
+
+namespace jerryct {
+namespace telemetry {
+
+namespace {
+
+// Bounds the completed events waiting for their parent; beyond they are attached where they are.
+constexpr std::size_t max_completed{65536U};
+
+} // namespace
+
+CallTree::Tree::Tree() : nodes{Node{0U, 0U, 0, {}, {}}}, children{} {}
+
+std::uint32_t CallTree::Tree::Child(const std::uint32_t parent, const std::uint32_t name) {
+  const std::uint64_t key{(std::uint64_t{parent} << 32U) | name};
+  const auto it = children.find(key);
+  if (it != children.end()) {
+    return it->second;
+  }
+  const auto child = static_cast<std::uint32_t>(nodes.size());
+  nodes.push_back(Node{name, parent, 0, {}, {}});
+  children.emplace(key, child);
+  return child;
+}
+
+void CallTree::Tree::Add(const std::uint32_t node, const std::chrono::nanoseconds total,
+                         const std::chrono::nanoseconds children) {
+  Node &n{nodes[node]};
+  ++n.calls;
+  n.total += total;
+  n.self += total - children;
+}
+
+void CallTree::Tree::Merge(const Tree &other) {
+  // As parents precede their children, one pass in index order suffices.
+  std::vector<std::uint32_t> to_merged(other.nodes.size(), 0U);
+  for (std::size_t i{1U}; i < other.nodes.size(); ++i) {
+    const Node &n{other.nodes[i]};
+    to_merged[i] = Child(to_merged[n.parent], n.name);
+    Node &m{nodes[to_merged[i]]};
+    m.calls += n.calls;
+    m.total += n.total;
+    m.self += n.self;
+  }
+}
+
+void CallTree::operator()(const std::int32_t tid, const Segments<Event> &events, const NameTable &names,
+                          const TimeBase &time_base) {
+  Thread &t{threads_[tid]};
+  for (const Event &e : events) {
+    switch (e.phase) {
+    case Phase::begin: {
+      Label(e.name, names);
+      const std::uint32_t parent{t.stack.empty() ? 0U : t.stack.back().node};
+      const std::uint32_t node{t.tree.Child(parent, e.name)};
+      // Only complete events of its children precede a begin, namely if a long span fell back to begin and end.
+      t.stack.push_back(Frame{node, e.time_stamp, Adopt(t, node, e.time_stamp)});
+    } break;
+    case Phase::end:
+      if (!t.stack.empty()) {
+        Frame f{t.stack.back()};
+        t.stack.pop_back();
+        f.children += Adopt(t, f.node, f.ts);
+        const std::chrono::nanoseconds d{time_base.ToDuration(e.time_stamp - f.ts)};
+        t.tree.Add(f.node, d, f.children);
+        if (!t.stack.empty()) {
+          t.stack.back().children += d;
+        }
+      }
+      break;
+    case Phase::complete: {
+      Label(e.name, names);
+      // The preceding completed subtrees starting within this event are its children.
+      std::uint32_t size{1U};
+      std::chrono::nanoseconds children{};
+      std::size_t i{t.completed.size()};
+      while ((i != 0U) && StartsWithin(t.completed[i - 1U], e.time_stamp)) {
+        children += t.completed[i - 1U].total;
+        size += t.completed[i - 1U].size;
+        i -= t.completed[i - 1U].size;
+      }
+      t.completed.push_back(Completed{e.name, e.time_stamp, e.time_stamp + std::int64_t{e.duration},
+                                      time_base.ToDuration(e.duration), children, size});
+    } break;
+    case Phase::async_begin:
+    case Phase::async_end:
+    case Phase::flow_start:
+    case Phase::flow_end:
+    case Phase::arg_int:
+    case Phase::arg_uint:
+    case Phase::arg_double:
+    case Phase::arg_string:
+      break;
+    }
+  }
+
+  if (t.completed.size() > max_completed) {
+    AdoptAll(t);
+  }
+}
+
+CallTree::Tree CallTree::TakeWindow() {
+  Tree merged{};
+  for (auto &thread : threads_) {
+    Thread &t{thread.second};
+    merged.Merge(t.tree);
+    for (Node &n : t.tree.nodes) {
+      n.calls = 0;
+      n.total = {};
+      n.self = {};
+    }
+  }
+  return merged;
+}
+
+void CallTree::Flush() {
+  for (auto &thread : threads_) {
+    AdoptAll(thread.second);
+  }
+}
+
+std::chrono::nanoseconds CallTree::Adopt(Thread &t, const std::uint32_t parent, const std::int64_t ts) {
+  std::chrono::nanoseconds total{};
+  while (!t.completed.empty() && StartsWithin(t.completed.back(), ts)) {
+    const Completed &c{t.completed.back()};
+    total += c.total;
+    Commit(t.tree, parent, t.completed, t.completed.size());
+    t.completed.resize(t.completed.size() - c.size);
+  }
+  return total;
+}
+
+void CallTree::AdoptAll(Thread &t) {
+  const std::uint32_t parent{t.stack.empty() ? 0U : t.stack.back().node};
+  const std::chrono::nanoseconds d{Adopt(t, parent, std::numeric_limits<std::int64_t>::min())};
+  if (!t.stack.empty()) {
+    t.stack.back().children += d;
+  }
+}
+
+void CallTree::Commit(Tree &tree, const std::uint32_t parent, const std::vector<Completed> &completed,
+                      const std::size_t end) {
+  const Completed &c{completed[end - 1U]};
+  const std::uint32_t node{tree.Child(parent, c.name)};
+  tree.Add(node, c.total, c.children);
+  std::size_t i{end - 1U};
+  const std::size_t first{end - c.size};
+  while (i != first) {
+    const std::uint32_t size{completed[i - 1U].size};
+    Commit(tree, node, completed, i);
+    i -= size;
+  }
+}
+
+void CallTree::Label(const std::uint32_t name, const NameTable &names) {
+  if (name >= labels_.size()) {
+    labels_.resize(name + 1U);
+  }
+  if (labels_[name].empty()) {
+    const string_view n{names.Get(name)};
+    labels_[name].assign(n.data(), n.size());
+  }
+}
+
+} // namespace telemetry
+} // namespace jerryct
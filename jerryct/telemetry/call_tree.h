@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: MIT
+
+#ifndef JERRYCT_TELEMETRY_CALL_TREE_H
+#define JERRYCT_TELEMETRY_CALL_TREE_H
+
+#include "jerryct/telemetry/tracer.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace jerryct {
+namespace telemetry {
+
+// Spans aggregated by their path from the root span. Each node holds its calls, its total time and its self time, i.e.
+// the total minus the time spent in child spans. Every thread builds its own tree from its events; TakeWindow() merges
+// them by path.
+//
+// Complete events arrive after their children, as a span ends after its children. Such children wait until the
+// enclosing span arrives, also across windows, so a long running parent still open while a window is taken keeps its
+// children. Only beyond max_completed waiting events per thread, or on Flush(), they are attached to the innermost open
+// span. A waiting span is a child if it started within the enclosing span and ended after its start: a preceding
+// sibling was emitted before the enclosing span started. A zero-length span at the start tick of the enclosing span,
+// common with a coarse clock, is hence taken for a sibling.
+class CallTree {
+public:
+  struct Node {
+    std::uint32_t name;
+    std::uint32_t parent;
+    std::int64_t calls;
+    std::chrono::nanoseconds total;
+    std::chrono::nanoseconds self;
+  };
+
+  // Node 0 is the root above all spans. Parents precede their children.
+  struct Tree {
+    Tree();
+    std::uint32_t Child(const std::uint32_t parent, const std::uint32_t name);
+    void Add(const std::uint32_t node, const std::chrono::nanoseconds total, const std::chrono::nanoseconds children);
+    // Adds the values of other to the nodes of the same paths.
+    void Merge(const Tree &other);
+
+    std::vector<Node> nodes;
+    // Child per parent and name, keyed by parent << 32 | name.
+    std::unordered_map<std::uint64_t, std::uint32_t> children;
+  };
+
+  void operator()(const std::int32_t tid, const Segments<Event> &events, const NameTable &names,
+                  const TimeBase &time_base);
+
+  // The merged tree of all threads since the previous call. Spans still waiting for their parent are left for a later
+  // window.
+  Tree TakeWindow();
+
+  // Attaches all spans waiting for their parent to the innermost open span, e.g. before the last TakeWindow().
+  void Flush();
+
+  // Name of a span seen before, independent of the lifetime of the name table.
+  const std::string &Label(const std::uint32_t name) const { return labels_[name]; }
+
+private:
+  struct Frame {
+    std::uint32_t node;
+    std::int64_t ts;
+    std::chrono::nanoseconds children;
+  };
+
+  // A complete event waiting for its parent, stored in post-order: a subtree of size n is the event preceded by the
+  // n - 1 records of its descendants.
+  struct Completed {
+    std::uint32_t name;
+    std::int64_t ts;
+    std::int64_t end;
+    std::chrono::nanoseconds total;
+    std::chrono::nanoseconds children;
+    std::uint32_t size;
+  };
+
+  struct Thread {
+    Tree tree;
+    std::vector<Frame> stack;
+    std::vector<Completed> completed;
+  };
+
+  static bool StartsWithin(const Completed &c, const std::int64_t ts) noexcept { return (c.ts >= ts) && (c.end > ts); }
+  // Moves the completed subtrees starting within a span starting at ts below parent; returns their total time.
+  static std::chrono::nanoseconds Adopt(Thread &t, const std::uint32_t parent, const std::int64_t ts);
+  // Moves all completed subtrees below the innermost open span.
+  static void AdoptAll(Thread &t);
+  static void Commit(Tree &tree, const std::uint32_t parent, const std::vector<Completed> &completed,
+                     const std::size_t end);
+  void Label(const std::uint32_t name, const NameTable &names);
+
+  std::unordered_map<std::int32_t, Thread> threads_;
+  std::vector<std::string> labels_;
+};
+
+} // namespace telemetry
+} // namespace jerryct
+
+#endif // JERRYCT_TELEMETRY_CALL_TREE_H
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/call_tree_exporter.h"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace jerryct {
+namespace telemetry {
+
+CallTreeExporter::~CallTreeExporter() noexcept {
+  try {
+    Flush();
+    Print();
+  } catch (...) {
+    // The last window is lost; a destructor cannot report the error.
+  }
+}
+
+void CallTreeExporter::operator()(const std::int32_t tid, const std::uint64_t /*unused*/, const Segments<Event> &events,
+                                  const NameTable &names, const TimeBase &time_base) {
+  tree_(tid, events, names, time_base);
+}
+
+void CallTreeExporter::Print() {
+  const CallTree::Tree merged{tree_.TakeWindow()};
+
+  // Calls of each subtree, to skip paths without spans in this window.
+  std::vector<std::int64_t> calls(merged.nodes.size(), 0);
+  std::vector<std::vector<std::uint32_t>> kids(merged.nodes.size());
+  for (std::size_t i{merged.nodes.size() - 1U}; i > 0U; --i) {
+    calls[i] += merged.nodes[i].calls;
+    calls[merged.nodes[i].parent] += calls[i];
+    kids[merged.nodes[i].parent].push_back(static_cast<std::uint32_t>(i));
+  }
+
+  printf("      calls          total           self name\n");
+  struct Visit {
+    std::uint32_t node;
+    std::int32_t depth;
+  };
+  std::vector<Visit> todo{{0U, -1}};
+  while (!todo.empty()) {
+    const Visit v{todo.back()};
+    todo.pop_back();
+    if (v.node != 0U) {
+      const CallTree::Node &n{merged.nodes[v.node]};
+      printf("%11ld %11ld ns %11ld ns %*s%s\n", n.calls, n.total.count(), n.self.count(), 2 * v.depth, "",
+             tree_.Label(n.name).c_str());
+    }
+    // Largest total first, hence pushed last.
+    std::vector<std::uint32_t> &k{kids[v.node]};
+    std::sort(k.begin(), k.end(), [&merged](const std::uint32_t a, const std::uint32_t b) {
+      return merged.nodes[a].total < merged.nodes[b].total;
+    });
+    for (const std::uint32_t c : k) {
+      if (calls[c] != 0) {
+        todo.push_back(Visit{c, v.depth + 1});
+      }
+    }
+  }
+}
+
+} // namespace telemetry
+} // namespace jerryct
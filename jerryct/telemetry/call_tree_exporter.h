@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: MIT
+
+#ifndef JERRYCT_TELEMETRY_CALL_TREE_EXPORTER_H
+#define JERRYCT_TELEMETRY_CALL_TREE_EXPORTER_H
+
+#include "jerryct/telemetry/call_tree.h"
+#include "jerryct/telemetry/tracer.h"
+#include <cstdint>
+
+namespace jerryct {
+namespace telemetry {
+
+// Reports spans by their path from the root span instead of by name alone, so "Baz" called from "Foo" and from "Bar"
+// are reported apart, each with its calls, total time and self time. See CallTree.
+class CallTreeExporter {
+public:
+  CallTreeExporter() = default;
+  CallTreeExporter(const CallTreeExporter &) = delete;
+  CallTreeExporter(CallTreeExporter &&other) noexcept = default;
+  CallTreeExporter &operator=(const CallTreeExporter &) = delete;
+  CallTreeExporter &operator=(CallTreeExporter &&other) noexcept = default;
+  // Prints a last time, including spans whose parent never arrived.
+  ~CallTreeExporter() noexcept;
+
+  void operator()(const std::int32_t tid, const std::uint64_t /*unused*/, const Segments<Event> &events,
+                  const NameTable &names, const TimeBase &time_base);
+
+  // Prints the tree merged over all threads of the window since the previous Print() and starts a new one. Completed
+  // spans still waiting for their parent are printed with it in a later window, see CallTree.
+  void Print();
+
+  // Gives up waiting for the parents of completed spans, e.g. once the traced program finished, see CallTree::Flush().
+  void Flush() { tree_.Flush(); }
+
+private:
+  CallTree tree_;
+};
+
+} // namespace telemetry
+} // namespace jerryct
+
+#endif // JERRYCT_TELEMETRY_CALL_TREE_EXPORTER_H
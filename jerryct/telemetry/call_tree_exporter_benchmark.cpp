@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/call_tree_exporter.h"
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Events per second through the call tree: three levels of nested spans with a few names per level.
+void ExportCallTreeEvents(benchmark::State &state) {
+  jerryct::telemetry::NameTable names{};
+  names.Register("");
+  std::vector<std::uint32_t> ids{};
+  for (std::int32_t i{0}; i < 4; ++i) {
+    ids.push_back(names.Register("span " + std::to_string(i)) & 0xFFFFFFU);
+  }
+  std::vector<jerryct::telemetry::Event> events{};
+  std::int64_t ts{0};
+  for (std::size_t i{0U}; i < 128U; ++i) {
+    for (std::size_t level{0U}; level < 3U; ++level) {
+      events.push_back(
+          jerryct::telemetry::Event{jerryct::telemetry::Phase::begin, ids[(i + level) % 4U] & 0xFFFFFFU, 0U, ts++});
+    }
+    for (std::size_t level{0U}; level < 3U; ++level) {
+      events.push_back(jerryct::telemetry::Event{jerryct::telemetry::Phase::end, 0U, 0U, ts++});
+    }
+  }
+  const jerryct::telemetry::Segments<jerryct::telemetry::Event> segments{
+      jerryct::telemetry::Segment<jerryct::telemetry::Event>{events.data(), events.data() + events.size()}};
+  jerryct::telemetry::CallTreeExporter tree{};
+
+  for (auto _ : state) {
+    tree(0, 0U, segments, names, jerryct::telemetry::TimeBase{});
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(events.size()));
+}
+
+BENCHMARK(ExportCallTreeEvents);
+
+} // namespace
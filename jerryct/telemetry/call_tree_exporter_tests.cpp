@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/call_tree_exporter.h"
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace jerryct {
+namespace telemetry {
+namespace {
+
+class CallTreeExporterTest : public testing::Test {
+protected:
+  CallTreeExporterTest() {
+    names_.Register("");
+    names_.Register("Foo");
+    names_.Register("Bar");
+    names_.Register("Baz");
+  }
+
+  void Export(const std::int32_t tid, const std::vector<Event> &events) {
+    tree_(tid, 0U, Segments<Event>{Segment<Event>{events.data(), events.data() + events.size()}}, names_, TimeBase{});
+  }
+
+  std::string Print(const bool flush = false) {
+    if (flush) {
+      tree_.Flush();
+    }
+    testing::internal::CaptureStdout();
+    tree_.Print();
+    return testing::internal::GetCapturedStdout();
+  }
+
+  static std::string Line(const std::int64_t calls, const std::int64_t total, const std::int64_t self,
+                          const std::string &name) {
+    return fmt::format("{:>11} {:>11} ns {:>11} ns {}\n", calls, total, self, name);
+  }
+
+  NameTable names_{};
+  CallTreeExporter tree_{};
+};
+
+const std::string header{"      calls          total           self name\n"};
+
+TEST_F(CallTreeExporterTest, WhenSameNameUnderDifferentParents_ExpectSeparateNodesWithSelfTime) {
+  Export(0, {Event{Phase::begin, 1U, 0U, 0}, Event{Phase::begin, 3U, 0U, 10}, Event{Phase::end, 0U, 0U, 40},
+             Event{Phase::end, 0U, 0U, 100}, Event{Phase::begin, 2U, 0U, 100}, Event{Phase::begin, 3U, 0U, 110},
+             Event{Phase::end, 0U, 0U, 120}, Event{Phase::end, 0U, 0U, 150}});
+
+  EXPECT_EQ(header + Line(1, 100, 70, "Foo") + Line(1, 30, 30, "  Baz") + Line(1, 50, 40, "Bar") +
+                Line(1, 10, 10, "  Baz"),
+            Print());
+}
+
+TEST_F(CallTreeExporterTest, WhenCompleteEvents_ExpectChildrenAttachedToLaterParent) {
+  Export(0, {Event{Phase::complete, 3U, 20U, 10}, Event{Phase::complete, 3U, 10U, 50}});
+  Export(0, {Event{Phase::complete, 1U, 100U, 0}});
+
+  EXPECT_EQ(header + Line(1, 100, 70, "Foo") + Line(2, 30, 30, "  Baz"), Print(true));
+}
+
+TEST_F(CallTreeExporterTest, WhenSiblingsStartAtSameTick_ExpectNotNested) {
+  Export(0,
+         {Event{Phase::complete, 3U, 0U, 10}, Event{Phase::complete, 2U, 5U, 10}, Event{Phase::complete, 1U, 100U, 0}});
+
+  EXPECT_EQ(header + Line(1, 100, 95, "Foo") + Line(1, 5, 5, "  Bar") + Line(1, 0, 0, "  Baz"), Print(true));
+}
+
+TEST_F(CallTreeExporterTest, WhenWindowTakenBeforeParentArrives_ExpectChildrenKeptForParent) {
+  Export(0, {Event{Phase::complete, 3U, 20U, 10}});
+  EXPECT_EQ(header, Print());
+  Export(0, {Event{Phase::complete, 1U, 100U, 0}});
+
+  EXPECT_EQ(header + Line(1, 100, 80, "Foo") + Line(1, 20, 20, "  Baz"), Print(true));
+}
+
+TEST_F(CallTreeExporterTest, WhenParentNeverArrives_ExpectAttachedToRootOnFlush) {
+  {
+    CallTreeExporter tree{};
+    const std::vector<Event> events{Event{Phase::complete, 3U, 20U, 10}};
+    tree(0, 0U, Segments<Event>{Segment<Event>{events.data(), events.data() + events.size()}}, names_, TimeBase{});
+    testing::internal::CaptureStdout();
+  }
+
+  EXPECT_EQ(header + Line(1, 20, 20, "Baz"), testing::internal::GetCapturedStdout());
+}
+
+TEST_F(CallTreeExporterTest, WhenLongSpanFallsBackToBeginEnd_ExpectCompletedChildrenAttached) {
+  Export(0, {Event{Phase::complete, 3U, 20U, 10}, Event{Phase::begin, 1U, 0U, 0}, Event{Phase::end, 0U, 0U, 100}});
+
+  EXPECT_EQ(header + Line(1, 100, 80, "Foo") + Line(1, 20, 20, "  Baz"), Print());
+}
+
+TEST_F(CallTreeExporterTest, WhenCompleteInsideBeginEnd_ExpectAttachedToOpenSpan) {
+  Export(0, {Event{Phase::begin, 1U, 0U, 0}, Event{Phase::complete, 3U, 20U, 10}, Event{Phase::end, 0U, 0U, 100}});
+
+  EXPECT_EQ(header + Line(1, 100, 80, "Foo") + Line(1, 20, 20, "  Baz"), Print());
+}
+
+TEST_F(CallTreeExporterTest, WhenSamePathOnSeveralThreads_ExpectMerged) {
+  Export(0, {Event{Phase::begin, 1U, 0U, 0}, Event{Phase::begin, 3U, 0U, 10}, Event{Phase::end, 0U, 0U, 20},
+             Event{Phase::end, 0U, 0U, 30}});
+  Export(1, {Event{Phase::begin, 1U, 0U, 0}, Event{Phase::begin, 3U, 0U, 10}, Event{Phase::end, 0U, 0U, 30},
+             Event{Phase::end, 0U, 0U, 50}});
+
+  EXPECT_EQ(header + Line(2, 80, 50, "Foo") + Line(2, 30, 30, "  Baz"), Print());
+}
+
+TEST_F(CallTreeExporterTest, WhenPrintedAgain_ExpectNewWindow) {
+  Export(0, {Event{Phase::begin, 1U, 0U, 0}, Event{Phase::begin, 3U, 0U, 10}, Event{Phase::end, 0U, 0U, 20}});
+  Print();
+  Export(0, {Event{Phase::end, 0U, 0U, 30}});
+
+  EXPECT_EQ(header + Line(1, 30, 20, "Foo"), Print());
+}
+
+} // namespace
+} // namespace telemetry
+} // namespace jerryct
@@ -1,104 +1,318 @@
 // SPDX-License-Identifier: MIT
 
 #include "jerryct/telemetry/chrome_trace_event_exporter.h"
+#include "jerryct/telemetry/json_format.h"
 #include <chrono>
 #include <cstdio>
 #include <fmt/core.h>
+#include <iterator>
+#include <stdexcept>
 #include <string>
+#include <system_error>
+#include <utility>
+#include <zlib.h>
 
 namespace jerryct {
 namespace telemetry {
 
-FileRotate::FileRotate(const std::string &filename) : f_{}, rotation_size_{5}, filename_{filename} { Rotate(); }
+void FileRotate::DeflateEnd::operator()(z_stream_s *const z) const noexcept {
+  deflateEnd(z);
+  delete z;
+}
+
+FileRotate::FileRotate(const std::string &filename, const FileRotateOptions &options)
+    : f_{}, z_{}, options_{options}, filename_{filename} {
+  if (options_.gzip) {
+    z_.reset(new z_stream{});
+    // 15 + 16: the largest window with a gzip header and trailer instead of a zlib wrapper.
+    if (deflateInit2(z_.get(), Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+      z_.reset();
+      throw std::runtime_error{"cannot initialize gzip compression"};
+    }
+  }
+  Rotate();
+}
+
+FileRotate::FileRotate(FileRotate &&other) noexcept = default;
+
+FileRotate &FileRotate::operator=(FileRotate &&other) noexcept {
+  if (this != &other) {
+    Close();
+    f_ = std::move(other.f_);
+    z_ = std::move(other.z_);
+    options_ = std::move(other.options_);
+    filename_ = std::move(other.filename_);
+    bytes_ = other.bytes_;
+    opened_ = other.opened_;
+    error_ = other.error_;
+  }
+  return *this;
+}
+
+FileRotate::~FileRotate() noexcept { Close(); }
+
+void FileRotate::Write(const void *data, const std::size_t size) {
+  if (!z_) {
+    f_.Write(data, size);
+    bytes_ += size;
+    return;
+  }
+  z_->next_in = static_cast<Bytef *>(const_cast<void *>(data));
+  z_->avail_in = static_cast<uInt>(size);
+  Deflate(Z_NO_FLUSH);
+}
+
+bool FileRotate::Due() const {
+  return ((options_.max_bytes != 0U) && (bytes_ >= options_.max_bytes)) ||
+         ((options_.max_age != std::chrono::steady_clock::duration{0}) &&
+          ((std::chrono::steady_clock::now() - opened_) >= options_.max_age));
+}
 
 void FileRotate::Rotate() {
-  std::remove((filename_ + std::to_string(rotation_size_ - 1)).c_str());
-  for (std::int32_t i{rotation_size_ - 1}; i > 1; --i) {
-    std::rename((filename_ + std::to_string(i - 1)).c_str(), (filename_ + std::to_string(i)).c_str());
+  Close();
+  if (options_.files > 1) {
+    std::remove(Name(options_.files - 1).c_str());
+    for (std::int32_t i{options_.files - 1}; i > 0; --i) {
+      std::rename(Name(i - 1).c_str(), Name(i).c_str());
+    }
   }
-  std::rename(filename_.c_str(), (filename_ + std::to_string(1)).c_str());
 
-  f_ = {filename_, "w"};
+  // Truncates the file in place if no rotated files are kept.
+  f_ = FileSink{Name(0), options_.sink};
+  if (z_) {
+    deflateReset(z_.get());
+  }
+  bytes_ = 0U;
+  opened_ = std::chrono::steady_clock::now();
+}
+
+std::string FileRotate::Name(const std::int32_t i) const {
+  std::string name{filename_};
+  if (i != 0) {
+    name += std::to_string(i);
+  }
+  if (options_.gzip) {
+    name += ".gz";
+  }
+  return name;
 }
 
-std::FILE *FileRotate::Get() const { return f_.get(); }
+void FileRotate::Deflate(const int flush) {
+  Bytef out[16384];
+  do {
+    z_->next_out = out;
+    z_->avail_out = sizeof(out);
+    if (deflate(z_.get(), flush) == Z_STREAM_ERROR) {
+      Fail(std::make_error_code(std::errc::io_error));
+      return;
+    }
+    const std::size_t n{sizeof(out) - z_->avail_out};
+    f_.Write(out, n);
+    bytes_ += n;
+  } while (z_->avail_out == 0U);
+}
 
-ChromeTraceEventExporter::ChromeTraceEventExporter(const std::string &filename) : f_{filename} {
-  std::fprintf(f_.Get(), "[");
+void FileRotate::Close() noexcept {
+  if (f_.IsOpen() && z_) {
+    try {
+      Deflate(Z_FINISH);
+    } catch (const std::system_error &e) {
+      Fail(e.code());
+    } catch (...) {
+      Fail(std::make_error_code(std::errc::not_enough_memory));
+    }
+  }
+  f_.Close();
+  Fail(f_.Error());
+}
+
+void FileRotate::Fail(const std::error_code error) noexcept {
+  if (!error_) {
+    error_ = error;
+  }
+}
+
+ChromeTraceEventExporter::ChromeTraceEventExporter(const std::string &filename, const FileRotateOptions &options)
+    : f_{filename, options} {
+  f_.Write("[");
 }
 
 ChromeTraceEventExporter &ChromeTraceEventExporter::operator=(ChromeTraceEventExporter &&other) {
-  if (f_.Get() != nullptr) {
-    std::fprintf(f_.Get(), "{}]");
+  if (f_.IsOpen()) {
+    f_.Write("{}]");
   }
   f_ = std::move(other.f_);
   buf_ = std::move(other.buf_);
+  args_ = std::move(other.args_);
   return *this;
 }
 
 ChromeTraceEventExporter::~ChromeTraceEventExporter() noexcept {
-  if (f_.Get() != nullptr) {
-    std::fprintf(f_.Get(), "{}]");
+  if (f_.IsOpen()) {
+    try {
+      f_.Write("{}]");
+    } catch (...) {
+      // The file lacks the end of the array; a destructor cannot report the error.
+    }
   }
 }
 
 namespace {
 
+using Fragment = fmt::basic_memory_buffer<char, 64>;
+
+// The parts of the events naming the thread, formatted once per export instead of once per event.
+struct Fragments {
+  explicit Fragments(const std::int32_t tid) {
+    fmt::format_to(std::back_inserter(begin), R"(","pid":0,"tid":{},"ph":"B","ts":)", tid);
+    fmt::format_to(std::back_inserter(end), R"({{"pid":0,"tid":{},"ph":"E","ts":)", tid);
+    fmt::format_to(std::back_inserter(complete), R"(","pid":0,"tid":{},"ph":"X","ts":)", tid);
+    fmt::format_to(std::back_inserter(with_id), R"(,"pid":0,"tid":{},"ph":)", tid);
+  }
+
+  Fragment begin;
+  Fragment end;
+  Fragment complete;
+  Fragment with_id;
+};
+
+void Append(const Fragment &f, fmt::memory_buffer &buf) { buf.append(f.data(), f.data() + f.size()); }
+
 void FormatAsMicro(const std::chrono::steady_clock::time_point tp, fmt::memory_buffer &buf) {
-  const auto micro = std::chrono::duration_cast<std::chrono::microseconds>(tp.time_since_epoch());
-  buf.append(fmt::format_int{micro.count()});
-  buf.push_back('.');
-  const auto nano = (tp.time_since_epoch() - micro).count();
-  if (nano < 100) {
-    buf.push_back('0');
+  AppendMicros(tp.time_since_epoch(), buf);
+}
+
+// Appends "key":value to the arguments waiting for the end of their span.
+void FormatArg(const Event &e, const NameTable &names, fmt::memory_buffer &args) {
+  if (args.size() != 0U) {
+    args.push_back(',');
   }
-  if (nano < 10) {
-    buf.push_back('0');
+  args.push_back('"');
+  AppendJsonEscaped(names.Get(e.name), args);
+  args.append(fmt::string_view{R"(":)"});
+  switch (e.phase) {
+  case Phase::arg_int:
+    args.append(fmt::format_int{ArgInt(e)});
+    break;
+  case Phase::arg_uint:
+    args.append(fmt::format_int{ArgUint(e)});
+    break;
+  case Phase::arg_double:
+    fmt::format_to(std::back_inserter(args), "{}", ArgDouble(e));
+    break;
+  default: {
+    char bytes[max_arg_string];
+    args.push_back('"');
+    AppendJsonEscaped(ArgString(e, bytes), args);
+    args.push_back('"');
+  } break;
+  }
+}
+
+void FormatArgs(fmt::memory_buffer &args, fmt::memory_buffer &buf) {
+  if (args.size() != 0U) {
+    buf.append(fmt::string_view{R"(,"args":{)"});
+    buf.append(fmt::string_view{args.data(), args.size()});
+    buf.push_back('}');
+    args.clear();
   }
-  buf.append(fmt::format_int{nano});
+}
+
+// Async and flow events are matched by category, name and id instead of by tid. ph carries any extra fields.
+void FormatWithId(const Event &e, const fmt::string_view category, const fmt::string_view ph, const Fragments &f,
+                  const NameTable &names, const TimeBase &time_base, fmt::memory_buffer &buf) {
+  buf.append(fmt::string_view{R"({"name":")"});
+  AppendJsonEscaped(names.Get(e.name), buf);
+  buf.append(fmt::string_view{R"(","cat":")"});
+  buf.append(category);
+  buf.append(fmt::string_view{R"(","id":)"});
+  buf.append(fmt::format_int{e.duration});
+  Append(f.with_id, buf);
+  buf.append(ph);
+  buf.append(fmt::string_view{R"(,"ts":)"});
+  FormatAsMicro(time_base.ToTimePoint(e.time_stamp), buf);
+  buf.append(fmt::string_view{R"(},)"});
 }
 
 } // namespace
 
 void ChromeTraceEventExporter::operator()(const std::int32_t tid, const std::uint64_t losts,
-                                          const std::vector<Event> &events) {
+                                          const Segments<Event> &events, const NameTable &names,
+                                          const TimeBase &time_base) {
+  fmt::memory_buffer &args{args_[tid]};
+  const Fragments f{tid};
+  const Event *last{nullptr};
   for (const Event &e : events) {
+    if (!IsArg(e)) {
+      last = &e;
+    }
     switch (e.phase) {
     case Phase::begin:
       buf_.append(fmt::string_view{R"({"name":")"});
-      buf_.append(e.name.Get());
-      buf_.append(fmt::string_view{R"(","pid":0,"tid":)"});
-      buf_.append(fmt::format_int{tid});
-      buf_.append(fmt::string_view{R"(,"ph":"B","ts":)"});
-      FormatAsMicro(e.time_stamp, buf_);
+      AppendJsonEscaped(names.Get(e.name), buf_);
+      Append(f.begin, buf_);
+      FormatAsMicro(time_base.ToTimePoint(e.time_stamp), buf_);
       buf_.append(fmt::string_view{R"(},)"});
       break;
     case Phase::end:
-      buf_.append(fmt::string_view{R"({"pid":0,"tid":)"});
-      buf_.append(fmt::format_int{tid});
-      buf_.append(fmt::string_view{R"(,"ph":"E","ts":)"});
-      FormatAsMicro(e.time_stamp, buf_);
+      Append(f.end, buf_);
+      FormatAsMicro(time_base.ToTimePoint(e.time_stamp), buf_);
+      FormatArgs(args, buf_);
       buf_.append(fmt::string_view{R"(},)"});
       break;
+    case Phase::complete:
+      buf_.append(fmt::string_view{R"({"name":")"});
+      AppendJsonEscaped(names.Get(e.name), buf_);
+      Append(f.complete, buf_);
+      FormatAsMicro(time_base.ToTimePoint(e.time_stamp), buf_);
+      buf_.append(fmt::string_view{R"(,"dur":)"});
+      AppendMicros(time_base.ToDuration(e.duration), buf_);
+      FormatArgs(args, buf_);
+      buf_.append(fmt::string_view{R"(},)"});
+      break;
+    case Phase::async_begin:
+      FormatWithId(e, "async", R"("b")", f, names, time_base, buf_);
+      break;
+    case Phase::async_end:
+      FormatWithId(e, "async", R"("e")", f, names, time_base, buf_);
+      break;
+    case Phase::flow_start:
+      FormatWithId(e, "flow", R"("s")", f, names, time_base, buf_);
+      break;
+    case Phase::flow_end:
+      // Binds to the enclosing span instead of the next one starting.
+      FormatWithId(e, "flow", R"("f","bp":"e")", f, names, time_base, buf_);
+      break;
+    case Phase::arg_int:
+    case Phase::arg_uint:
+    case Phase::arg_double:
+    case Phase::arg_string:
+      FormatArg(e, names, args);
+      break;
     }
   }
 
-  if (!events.empty()) {
+  // Stamped like the last event with a time stamp; the export may end between the arguments and the end of a span.
+  if (last != nullptr) {
     buf_.append(fmt::string_view{R"({"pid":0,"name":"total lost events","ph":"C","ts":)"});
-    FormatAsMicro(events.back().time_stamp, buf_);
+    FormatAsMicro(time_base.ToTimePoint(last->time_stamp), buf_);
     buf_.append(fmt::string_view{R"(,"args":{"value":)"});
     buf_.append(fmt::format_int{losts});
     buf_.append(fmt::string_view{R"(}},)"});
   }
 
-  std::fwrite(buf_.data(), 1, buf_.size(), f_.Get());
+  f_.Write(buf_.data(), buf_.size());
   buf_.clear();
+
+  if (f_.Due()) {
+    Rotate();
+  }
 }
 
 void ChromeTraceEventExporter::Rotate() {
-  std::fprintf(f_.Get(), "{}]");
+  f_.Write("{}]");
   f_.Rotate();
-  std::fprintf(f_.Get(), "[");
+  f_.Write("[");
 }
 
 } // namespace telemetry
@@ -3,45 +3,102 @@
 #ifndef JERRYCT_TELEMETRY_CHROME_TRACE_EVENT_EXPORTER_H
 #define JERRYCT_TELEMETRY_CHROME_TRACE_EVENT_EXPORTER_H
 
+#include "jerryct/telemetry/file_sink.h"
 #include "jerryct/telemetry/tracer.h"
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
-#include <cstdio>
 #include <fmt/format.h>
-#include <fmt/os.h>
+#include <memory>
 #include <string>
-#include <vector>
+#include <system_error>
+#include <unordered_map>
+
+struct z_stream_s;
 
 namespace jerryct {
 namespace telemetry {
 
+struct FileRotateOptions {
+  // Number of files kept: filename, filename1, ... filename<files - 1>. With 1 or less no rotated files are kept and
+  // rotating truncates filename.
+  std::int32_t files{5};
+  // Rotates once the current file holds at least this many bytes as written to disk. 0 disables the limit.
+  std::uint64_t max_bytes{0U};
+  // Rotates once the current file is older than this. 0 disables the limit.
+  std::chrono::steady_clock::duration max_age{0};
+  // Streams the files through gzip and appends ".gz" to their names, e.g. filename.gz and filename1.gz.
+  bool gzip{false};
+  FileSinkOptions sink{};
+};
+
+// The file written to and its rotated predecessors. Rotation is left to the owner, which only knows where the file
+// content may be cut, but Due() tells when a limit is reached.
 class FileRotate {
 public:
-  explicit FileRotate(const std::string &filename);
+  explicit FileRotate(const std::string &filename, const FileRotateOptions &options = {});
+  FileRotate(const FileRotate &) = delete;
+  FileRotate &operator=(const FileRotate &) = delete;
+  FileRotate(FileRotate &&other) noexcept;
+  FileRotate &operator=(FileRotate &&other) noexcept;
+  ~FileRotate() noexcept;
+
+  bool IsOpen() const noexcept { return f_.IsOpen(); }
+  // The first error writing any of the files, see FileSink::Error(), also if it occurred while closing a file.
+  std::error_code Error() const noexcept { return error_ ? error_ : f_.Error(); }
+
+  void Write(const void *data, const std::size_t size);
+  void Write(const string_view s) { Write(s.data(), s.size()); }
+
+  bool Due() const;
   void Rotate();
-  std::FILE *Get() const;
 
 private:
-  fmt::buffered_file f_;
-  std::int32_t rotation_size_;
+  struct DeflateEnd {
+    void operator()(z_stream_s *z) const noexcept;
+  };
+
+  // Name of the current file for 0, else of the i-th rotated one.
+  std::string Name(const std::int32_t i) const;
+  void Deflate(const int flush);
+  // Errors are kept by Error() instead of thrown.
+  void Close() noexcept;
+  void Fail(const std::error_code error) noexcept;
+
+  FileSink f_;
+  std::unique_ptr<z_stream_s, DeflateEnd> z_;
+  FileRotateOptions options_;
   std::string filename_;
+  std::uint64_t bytes_{0U};
+  std::chrono::steady_clock::time_point opened_{};
+  std::error_code error_{};
 };
 
 class ChromeTraceEventExporter {
 public:
-  explicit ChromeTraceEventExporter(const std::string &filename);
+  explicit ChromeTraceEventExporter(const std::string &filename, const FileRotateOptions &options = {});
   ChromeTraceEventExporter(const ChromeTraceEventExporter &) = delete;
   ChromeTraceEventExporter &operator=(const ChromeTraceEventExporter &) = delete;
   ChromeTraceEventExporter(ChromeTraceEventExporter &&other) = default;
   ChromeTraceEventExporter &operator=(ChromeTraceEventExporter &&other);
+  // Completes the JSON array; errors are ignored.
   ~ChromeTraceEventExporter() noexcept;
 
-  void operator()(const std::int32_t tid, const std::uint64_t losts, const std::vector<Event> &events);
+  // The first error writing the trace files, see FileRotate::Error().
+  std::error_code Error() const noexcept { return f_.Error(); }
+
+  void operator()(const std::int32_t tid, const std::uint64_t losts, const Segments<Event> &events,
+                  const NameTable &names, const TimeBase &time_base);
 
+  // Called automatically after an export once a limit of the FileRotateOptions is reached. Every file is a valid JSON
+  // array.
   void Rotate();
 
 private:
   FileRotate f_;
   fmt::memory_buffer buf_;
+  // Arguments per tid waiting for the end of their span, which may come with the next export.
+  std::unordered_map<std::int32_t, fmt::memory_buffer> args_;
 };
 
 } // namespace telemetry
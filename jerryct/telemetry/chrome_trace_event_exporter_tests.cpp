@@ -1,10 +1,14 @@
 // SPDX-License-Identifier: MIT
 
 #include "jerryct/telemetry/chrome_trace_event_exporter.h"
+#include <cstdio>
 #include <fstream>
 #include <gtest/gtest.h>
 #include <iterator>
 #include <string>
+#include <system_error>
+#include <vector>
+#include <zlib.h>
 
 namespace jerryct {
 namespace telemetry {
@@ -12,84 +16,180 @@ namespace {
 
 std::string Export(const std::int32_t tid, const std::uint64_t losts, const std::vector<Event> &events) {
   {
+    NameTable names{};
+    names.Register("");
+    names.Register("unknown");
+
     ChromeTraceEventExporter exporter{"test.json"};
-    exporter(tid, losts, events);
+    exporter(tid, losts, Segments<Event>{Segment<Event>{events.data(), events.data() + events.size()}}, names,
+             TimeBase{});
   }
   std::ifstream i{"test.json"};
   return {std::istreambuf_iterator<char>{i}, {}};
 }
 
+std::string Read(const std::string &filename) {
+  std::ifstream i{filename};
+  return {std::istreambuf_iterator<char>{i}, {}};
+}
+
+std::string ReadGzip(const std::string &filename) {
+  gzFile f{gzopen(filename.c_str(), "rb")};
+  std::string content{};
+  char buf[256];
+  int n{0};
+  while ((n = gzread(f, buf, sizeof(buf))) > 0) {
+    content.append(buf, static_cast<std::size_t>(n));
+  }
+  gzclose(f);
+  return content;
+}
+
+void ExportOne(const FileRotateOptions &options) {
+  NameTable names{};
+  names.Register("");
+  const std::vector<Event> events{Event{Phase::begin, 0U, 0U, 0}};
+
+  ChromeTraceEventExporter exporter{"test.json", options};
+  exporter(0, 0U, Segments<Event>{Segment<Event>{events.data(), events.data() + events.size()}}, names, TimeBase{});
+}
+
 TEST(ChromeTraceEventExporterTest, ZeroTimeStampFormatting) {
-  const Event event{Phase::begin, std::chrono::steady_clock::time_point{std::chrono::nanoseconds{}}, {}};
+  const Event event{Phase::begin, 0U, 0U, 0};
   const std::string content{Export(0, 0U, {event})};
 
   EXPECT_NE(std::string::npos, content.find(R"({"name":"","pid":0,"tid":0,"ph":"B","ts":0.000})"));
 }
 
 TEST(ChromeTraceEventExporterTest, SingleDigitTimeStampFormatting) {
-  const Event event{Phase::begin, std::chrono::steady_clock::time_point{std::chrono::nanoseconds{9}}, {}};
+  const Event event{Phase::begin, 0U, 0U, 9};
   const std::string content{Export(0, 0U, {event})};
 
   EXPECT_NE(std::string::npos, content.find(R"({"name":"","pid":0,"tid":0,"ph":"B","ts":0.009})"));
 }
 
 TEST(ChromeTraceEventExporterTest, DoubleDigitTimeStampFormatting) {
-  const Event event{Phase::begin, std::chrono::steady_clock::time_point{std::chrono::nanoseconds{99}}, {}};
+  const Event event{Phase::begin, 0U, 0U, 99};
   const std::string content{Export(0, 0U, {event})};
 
   EXPECT_NE(std::string::npos, content.find(R"({"name":"","pid":0,"tid":0,"ph":"B","ts":0.099})"));
 }
 
 TEST(ChromeTraceEventExporterTest, TripleDigitTimeStampFormatting) {
-  const Event event{Phase::begin, std::chrono::steady_clock::time_point{std::chrono::nanoseconds{999}}, {}};
+  const Event event{Phase::begin, 0U, 0U, 999};
   const std::string content{Export(0, 0U, {event})};
 
   EXPECT_NE(std::string::npos, content.find(R"({"name":"","pid":0,"tid":0,"ph":"B","ts":0.999})"));
 }
 
 TEST(ChromeTraceEventExporterTest, QuadrupleDigitTimeStampFormatting) {
-  const Event event{Phase::begin, std::chrono::steady_clock::time_point{std::chrono::microseconds{1}}, {}};
+  const Event event{Phase::begin, 0U, 0U, 1000};
   const std::string content{Export(0, 0U, {event})};
 
   EXPECT_NE(std::string::npos, content.find(R"({"name":"","pid":0,"tid":0,"ph":"B","ts":1.000})"));
 }
 
 TEST(ChromeTraceEventExporterTest, PhaseBeginFormatting) {
-  const Event event{Phase::begin, {}, {}};
+  const Event event{Phase::begin, 0U, 0U, 0};
   const std::string content{Export(0, 0U, {event})};
 
   EXPECT_NE(std::string::npos, content.find(R"({"name":"","pid":0,"tid":0,"ph":"B","ts":0.000})"));
 }
 
 TEST(ChromeTraceEventExporterTest, PhaseEndFormatting) {
-  const Event event{Phase::end, {}, {}};
+  const Event event{Phase::end, 0U, 0U, 0};
   const std::string content{Export(0, 0U, {event})};
 
   EXPECT_NE(std::string::npos, content.find(R"({"pid":0,"tid":0,"ph":"E","ts":0.000})"));
 }
 
+TEST(ChromeTraceEventExporterTest, PhaseCompleteFormatting) {
+  const Event event{Phase::complete, 0U, 1500U, 42000};
+  const std::string content{Export(0, 0U, {event})};
+
+  EXPECT_NE(std::string::npos, content.find(R"({"name":"","pid":0,"tid":0,"ph":"X","ts":42.000,"dur":1.500})"));
+}
+
+TEST(ChromeTraceEventExporterTest, PhaseAsyncFormatting) {
+  const std::string content{
+      Export(3, 0U, {Event{Phase::async_begin, 1U, 7U, 1000}, Event{Phase::async_end, 1U, 7U, 2000}})};
+
+  EXPECT_NE(std::string::npos,
+            content.find(R"({"name":"unknown","cat":"async","id":7,"pid":0,"tid":3,"ph":"b","ts":1.000})"));
+  EXPECT_NE(std::string::npos,
+            content.find(R"({"name":"unknown","cat":"async","id":7,"pid":0,"tid":3,"ph":"e","ts":2.000})"));
+}
+
+TEST(ChromeTraceEventExporterTest, PhaseFlowFormatting) {
+  const std::string content{
+      Export(3, 0U, {Event{Phase::flow_start, 1U, 7U, 1000}, Event{Phase::flow_end, 1U, 7U, 2000}})};
+
+  EXPECT_NE(std::string::npos,
+            content.find(R"({"name":"unknown","cat":"flow","id":7,"pid":0,"tid":3,"ph":"s","ts":1.000})"));
+  EXPECT_NE(std::string::npos,
+            content.find(R"({"name":"unknown","cat":"flow","id":7,"pid":0,"tid":3,"ph":"f","bp":"e","ts":2.000})"));
+}
+
+TEST(ChromeTraceEventExporterTest, ArgsFormatting) {
+  const std::vector<Event> events{MakeArg(1U, -3), MakeArg(1U, 4U), MakeArg(1U, 0.5), MakeArg(1U, string_view{"a\"b"}),
+                                  Event{Phase::end, 0U, 0U, 0}};
+  const std::string content{Export(0, 0U, events)};
+
+  EXPECT_NE(std::string::npos, content.find(R"({"pid":0,"tid":0,"ph":"E","ts":0.000,)"
+                                            R"("args":{"unknown":-3,"unknown":4,"unknown":0.5,"unknown":"a\"b"}})"));
+}
+
+TEST(ChromeTraceEventExporterTest, ArgsOfCompleteFormatting) {
+  const std::string content{Export(0, 0U, {MakeArg(1U, 7), Event{Phase::complete, 0U, 1500U, 42000}})};
+
+  EXPECT_NE(std::string::npos,
+            content.find(R"({"name":"","pid":0,"tid":0,"ph":"X","ts":42.000,"dur":1.500,"args":{"unknown":7}})"));
+}
+
 TEST(ChromeTraceEventExporterTest, NameFormatting) {
-  const Event event{Phase::begin, {}, {"unknown"}};
+  const Event event{Phase::begin, 1U, 0U, 0};
   const std::string content{Export(0, 0U, {event})};
 
   EXPECT_NE(std::string::npos, content.find(R"({"name":"unknown","pid":0,"tid":0,"ph":"B","ts":0.000})"));
 }
 
+TEST(ChromeTraceEventExporterTest, NameEscaping) {
+  NameTable names{};
+  names.Register(R"(say "hi" \ bye)");
+  const std::vector<Event> events{Event{Phase::begin, 0U, 0U, 0}, Event{Phase::async_begin, 0U, 1U, 0}};
+  {
+    ChromeTraceEventExporter exporter{"test.json"};
+    exporter(0, 0U, Segments<Event>{Segment<Event>{events.data(), events.data() + events.size()}}, names,
+             TimeBase{});
+  }
+  const std::string content{Read("test.json")};
+
+  EXPECT_NE(std::string::npos, content.find(R"({"name":"say \"hi\" \\ bye","pid":0,"tid":0,"ph":"B","ts":0.000})"));
+  EXPECT_NE(std::string::npos, content.find(R"({"name":"say \"hi\" \\ bye","cat":"async","id":1,)"));
+}
+
 TEST(ChromeTraceEventExporterTest, TidFormatting) {
-  const Event event{Phase::begin, {}, {}};
+  const Event event{Phase::begin, 0U, 0U, 0};
   const std::string content{Export(23, 0U, {event})};
 
   EXPECT_NE(std::string::npos, content.find(R"({"name":"","pid":0,"tid":23,"ph":"B","ts":0.000})"));
 }
 
 TEST(ChromeTraceEventExporterTest, LostsFormatting) {
-  const Event event{Phase::begin, std::chrono::steady_clock::time_point{std::chrono::microseconds{42}}, {}};
+  const Event event{Phase::begin, 0U, 0U, 42000};
   const std::string content{Export(0, 23U, {event})};
 
   EXPECT_NE(std::string::npos,
             content.find(R"({"pid":0,"name":"total lost events","ph":"C","ts":42.000,"args":{"value":23}})"));
 }
 
+TEST(ChromeTraceEventExporterTest, LostsFormatting_WhenExportEndsWithArgs) {
+  const std::string content{Export(0, 23U, {Event{Phase::begin, 0U, 0U, 42000}, MakeArg(1U, 99999999)})};
+
+  EXPECT_NE(std::string::npos,
+            content.find(R"({"pid":0,"name":"total lost events","ph":"C","ts":42.000,"args":{"value":23}})"));
+}
+
 TEST(ChromeTraceEventExporterTest, EmptyJson_WhenNoEvents) {
   const std::string content{Export(0, 0U, {})};
 
@@ -123,6 +223,70 @@ TEST(ChromeTraceEventExporterTest, Rotate) {
   }
 }
 
+TEST(ChromeTraceEventExporterTest, Rotate_WhenMaxBytesReached) {
+  FileRotateOptions options{};
+  options.max_bytes = 1U;
+  ExportOne(options);
+
+  EXPECT_EQ("[{}]", Read("test.json"));
+  EXPECT_EQ(R"([{"name":"","pid":0,"tid":0,"ph":"B","ts":0.000},)"
+            R"({"pid":0,"name":"total lost events","ph":"C","ts":0.000,"args":{"value":0}},{}])",
+            Read("test.json1"));
+}
+
+TEST(ChromeTraceEventExporterTest, Rotate_WhenSingleFile_ExpectTruncatedInPlace) {
+  std::remove("test.json0");
+  std::remove("test.json1");
+  FileRotateOptions options{};
+  options.files = 1;
+  options.max_bytes = 1U;
+  ExportOne(options);
+
+  EXPECT_EQ("[{}]", Read("test.json"));
+  EXPECT_FALSE(std::ifstream{"test.json0"}.good());
+  EXPECT_FALSE(std::ifstream{"test.json1"}.good());
+}
+
+TEST(ChromeTraceEventExporterTest, Rotate_WhenMaxAgeReached) {
+  FileRotateOptions options{};
+  options.max_age = std::chrono::nanoseconds{1};
+  ExportOne(options);
+
+  EXPECT_EQ("[{}]", Read("test.json"));
+  EXPECT_NE(std::string::npos, Read("test.json1").find(R"("ph":"B")"));
+}
+
+TEST(ChromeTraceEventExporterTest, NoRotate_WhenBelowLimits) {
+  FileRotateOptions options{};
+  options.max_bytes = 1U << 20U;
+  options.max_age = std::chrono::hours{1};
+  ExportOne(options);
+
+  EXPECT_NE(std::string::npos, Read("test.json").find(R"("ph":"B")"));
+}
+
+TEST(ChromeTraceEventExporterTest, Error_WhenWriteFailsBeforeRotation_ExpectKept) {
+  FileRotateOptions options{};
+  options.files = 1;
+  ChromeTraceEventExporter e{"/dev/full", options};
+  e.Rotate();
+
+  EXPECT_EQ(std::make_error_code(std::errc::no_space_on_device), e.Error());
+}
+
+TEST(ChromeTraceEventExporterTest, Gzip) {
+  FileRotateOptions options{};
+  options.gzip = true;
+  options.max_bytes = 1U;
+  ExportOne(options);
+
+  EXPECT_EQ("[{}]", ReadGzip("test.json.gz"));
+  const std::string rotated{ReadGzip("test.json1.gz")};
+  EXPECT_EQ('[', rotated.front());
+  EXPECT_NE(std::string::npos, rotated.find(R"("ph":"B")"));
+  EXPECT_EQ("{}]", rotated.substr(rotated.size() - 3U));
+}
+
 } // namespace
 } // namespace telemetry
 } // namespace jerryct
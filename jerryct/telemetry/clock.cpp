@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/clock.h"
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+namespace jerryct {
+namespace telemetry {
+
+namespace {
+
+TimeBase CalibrateTsc() {
+  const std::int64_t ticks0{Now(Clock::tsc)};
+  const auto time0 = std::chrono::steady_clock::now();
+
+  std::this_thread::sleep_for(std::chrono::milliseconds{10});
+
+  const std::int64_t ticks1{Now(Clock::tsc)};
+  const auto time1 = std::chrono::steady_clock::now();
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(time1 - time0);
+  return {ticks1, time1, static_cast<double>(elapsed.count()) / static_cast<double>(ticks1 - ticks0)};
+}
+
+} // namespace
+
+TimeBase TimeBase::Calibrate(const Clock clock) {
+  switch (clock) {
+  case Clock::steady:
+  case Clock::monotonic_coarse:
+    break;
+  case Clock::tsc: {
+#if defined(__x86_64__) || defined(__i386__)
+    static const TimeBase tsc{CalibrateTsc()};
+    return tsc;
+#else
+    break;
+#endif
+  }
+  }
+  return {};
+}
+
+Clock ClockFromEnvironment() {
+  const char *const value{std::getenv("JERRYCT_TELEMETRY_CLOCK")};
+  if (value == nullptr) {
+    return Clock::steady;
+  }
+  if (std::strcmp(value, "monotonic_coarse") == 0) {
+    return Clock::monotonic_coarse;
+  }
+  if (std::strcmp(value, "tsc") == 0) {
+    return Clock::tsc;
+  }
+  return Clock::steady;
+}
+
+} // namespace telemetry
+} // namespace jerryct
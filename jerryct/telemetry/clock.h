@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: MIT
+
+#ifndef JERRYCT_TELEMETRY_CLOCK_H
+#define JERRYCT_TELEMETRY_CLOCK_H
+
+#include <chrono>
+#include <cstdint>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace jerryct {
+namespace telemetry {
+
+// Time source used on the hot path. Time stamps are recorded as raw ticks of the selected clock and only converted to
+// nanoseconds by the exporters through a TimeBase.
+//
+// monotonic_coarse is cheap but only as precise as the scheduler tick (typically 1 to 4 ms). tsc assumes an invariant
+// time stamp counter which is synchronized across cores; it falls back to steady on non-x86 targets.
+enum class Clock : std::int32_t { steady, monotonic_coarse, tsc };
+
+inline std::int64_t Now(const Clock clock) noexcept {
+  switch (clock) {
+  case Clock::steady:
+    break;
+  case Clock::monotonic_coarse: {
+    timespec tp;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &tp);
+    return std::int64_t{tp.tv_sec} * 1000000000 + tp.tv_nsec;
+  }
+  case Clock::tsc:
+#if defined(__x86_64__) || defined(__i386__)
+    return static_cast<std::int64_t>(__rdtsc());
+#else
+    break;
+#endif
+  }
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Reads JERRYCT_TELEMETRY_CLOCK (steady, monotonic_coarse or tsc); steady if unset or unknown.
+Clock ClockFromEnvironment();
+
+// Maps raw ticks of a Clock onto the steady_clock time line.
+class TimeBase {
+public:
+  // Identity mapping, i.e. ticks are nanoseconds since the steady_clock epoch.
+  TimeBase() noexcept = default;
+  TimeBase(const std::int64_t ticks, const std::chrono::steady_clock::time_point time,
+           const double ns_per_tick) noexcept
+      : ticks_{ticks}, time_{time}, ns_per_tick_{ns_per_tick} {}
+
+  // For Clock::tsc the tick rate is measured once per process against steady_clock, which blocks the first caller
+  // for about 10 ms.
+  static TimeBase Calibrate(const Clock clock);
+
+  std::chrono::nanoseconds ToDuration(const std::int64_t ticks) const {
+    return std::chrono::nanoseconds{static_cast<std::int64_t>(static_cast<double>(ticks) * ns_per_tick_)};
+  }
+  std::chrono::steady_clock::time_point ToTimePoint(const std::int64_t ticks) const {
+    return time_ + ToDuration(ticks - ticks_);
+  }
+
+  std::int64_t Ticks() const noexcept { return ticks_; }
+  std::chrono::steady_clock::time_point Time() const noexcept { return time_; }
+  double NsPerTick() const noexcept { return ns_per_tick_; }
+
+private:
+  std::int64_t ticks_{0};
+  std::chrono::steady_clock::time_point time_{};
+  double ns_per_tick_{1.0};
+};
+
+} // namespace telemetry
+} // namespace jerryct
+
+#endif // JERRYCT_TELEMETRY_CLOCK_H
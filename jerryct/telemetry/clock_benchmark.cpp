@@ -1,5 +1,6 @@
 // SPDX-License-Identifier: MIT
 
+#include "jerryct/telemetry/clock.h"
 #include <benchmark/benchmark.h>
 #include <chrono>
 
@@ -23,8 +24,20 @@ void ClockGettime(benchmark::State &state) {
     benchmark::ClobberMemory();
   }
 }
+void ClockPolicy(benchmark::State &state) {
+  const auto clock = static_cast<jerryct::telemetry::Clock>(state.range(0));
+  for (auto _ : state) {
+    const auto now = jerryct::telemetry::Now(clock);
+    benchmark::DoNotOptimize(now);
+    benchmark::ClobberMemory();
+  }
+}
 
 BENCHMARK(Now);
 BENCHMARK(ClockGettime);
+BENCHMARK(ClockPolicy)
+    ->Arg(static_cast<int>(jerryct::telemetry::Clock::steady))
+    ->Arg(static_cast<int>(jerryct::telemetry::Clock::monotonic_coarse))
+    ->Arg(static_cast<int>(jerryct::telemetry::Clock::tsc));
 
 } // namespace
@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/clock.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace jerryct {
+namespace telemetry {
+namespace {
+
+TEST(ClockTest, IdentityTimeBase) {
+  const TimeBase time_base{};
+
+  EXPECT_EQ(std::chrono::nanoseconds{42}, time_base.ToDuration(42));
+  EXPECT_EQ(std::chrono::steady_clock::time_point{std::chrono::nanoseconds{42}}, time_base.ToTimePoint(42));
+}
+
+TEST(ClockTest, ScaledTimeBase) {
+  const TimeBase time_base{100, std::chrono::steady_clock::time_point{std::chrono::microseconds{1}}, 0.5};
+
+  EXPECT_EQ(std::chrono::nanoseconds{21}, time_base.ToDuration(42));
+  EXPECT_EQ(std::chrono::steady_clock::time_point{std::chrono::nanoseconds{1050}}, time_base.ToTimePoint(200));
+}
+
+TEST(ClockTest, Monotonic) {
+  for (const Clock clock : {Clock::steady, Clock::monotonic_coarse, Clock::tsc}) {
+    const std::int64_t t0{Now(clock)};
+    const std::int64_t t1{Now(clock)};
+    EXPECT_LE(t0, t1);
+  }
+}
+
+TEST(ClockTest, CalibratedTscFollowsSteadyClock) {
+  const TimeBase time_base{TimeBase::Calibrate(Clock::tsc)};
+
+  const std::int64_t t0{Now(Clock::tsc)};
+  const auto s0 = std::chrono::steady_clock::now();
+  std::this_thread::sleep_for(std::chrono::milliseconds{20});
+  const std::int64_t t1{Now(Clock::tsc)};
+  const auto s1 = std::chrono::steady_clock::now();
+
+  EXPECT_NEAR(std::chrono::duration<double>(s1 - s0).count(),
+              std::chrono::duration<double>(time_base.ToDuration(t1 - t0)).count(), 0.001);
+  EXPECT_NEAR(std::chrono::duration<double>(s1.time_since_epoch()).count(),
+              std::chrono::duration<double>(time_base.ToTimePoint(t1).time_since_epoch()).count(), 0.001);
+}
+
+} // namespace
+} // namespace telemetry
+} // namespace jerryct
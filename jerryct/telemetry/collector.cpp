@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/collector.h"
+#include <algorithm>
+
+namespace jerryct {
+namespace telemetry {
+
+namespace {
+
+// While serving OpenMetrics, incoming requests are polled at least this often.
+constexpr std::chrono::milliseconds serve_interval{10};
+
+} // namespace
+
+Collector::Collector(TracerImpl &tracer, MeterImpl &meter, const std::chrono::milliseconds period,
+                     const FanOutExporter::Execution execution)
+    : tracer_{tracer}, meter_{meter}, period_{period}, trace_exporters_{execution}, thread_{[this]() { Run(); }} {}
+
+Collector::~Collector() noexcept { Stop(); }
+
+void Collector::ServeOpenMetrics() {
+  std::lock_guard<std::mutex> guard{mutex_};
+  if (!open_metrics_) {
+    open_metrics_.reset(new OpenMetricsExporter{});
+  }
+}
+
+void Collector::Stop() {
+  {
+    std::lock_guard<std::mutex> guard{mutex_};
+    stop_ = true;
+  }
+  wake_up_.notify_one();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void Collector::Run() {
+  std::unique_lock<std::mutex> lock{mutex_};
+  auto next = std::chrono::steady_clock::now() + period_;
+  while (!stop_) {
+    const auto deadline = open_metrics_ ? std::min(next, std::chrono::steady_clock::now() + serve_interval) : next;
+    wake_up_.wait_until(lock, deadline, [this]() { return stop_; });
+    if (stop_) {
+      break;
+    }
+
+    if (std::chrono::steady_clock::now() >= next) {
+      Collect();
+      next = std::chrono::steady_clock::now() + period_;
+    }
+    if (open_metrics_) {
+      open_metrics_->Expose();
+    }
+  }
+  Collect();
+}
+
+void Collector::Collect() {
+  if (!trace_exporters_.Empty()) {
+    tracer_.Export(trace_exporters_);
+  }
+
+  if (!metric_exporters_.empty() || open_metrics_) {
+    meter_.Export([this](const Measurements<std::uint64_t> &counters) {
+      for (auto &e : metric_exporters_) {
+        e(counters);
+      }
+      if (open_metrics_) {
+        (*open_metrics_)(counters);
+      }
+    });
+  }
+
+  if (open_metrics_) {
+    meter_.ExportLabeledCounters(*open_metrics_);
+    meter_.ExportGauges(*open_metrics_);
+    meter_.ExportHistograms(*open_metrics_);
+  }
+}
+
+} // namespace telemetry
+} // namespace jerryct
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: MIT
+
+#ifndef JERRYCT_TELEMETRY_COLLECTOR_H
+#define JERRYCT_TELEMETRY_COLLECTOR_H
+
+#include "jerryct/string_view.h"
+#include "jerryct/telemetry/fan_out_exporter.h"
+#include "jerryct/telemetry/meter.h"
+#include "jerryct/telemetry/open_metrics_exporter.h"
+#include "jerryct/telemetry/tracer.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jerryct {
+namespace telemetry {
+
+// Drains a tracer and a meter on a dedicated thread every period and hands the data to all registered exporters, so
+// the instrumented threads never run exporter code. Each drain of a thread's events is passed to every trace exporter
+// through a FanOutExporter. On destruction the thread is stopped after a final drain.
+class Collector {
+public:
+  using MetricExporter = std::function<void(const Measurements<std::uint64_t> &)>;
+
+  Collector(TracerImpl &tracer, MeterImpl &meter, const std::chrono::milliseconds period,
+            const FanOutExporter::Execution execution = FanOutExporter::Execution::sequential);
+  Collector(const Collector &) = delete;
+  Collector(Collector &&) = delete;
+  Collector &operator=(const Collector &) = delete;
+  Collector &operator=(Collector &&) = delete;
+  ~Collector() noexcept;
+
+  // The collector takes ownership of the exporter; it is only called from the collector thread.
+  template <typename E> void AddTraceExporter(E &&exporter) {
+    std::lock_guard<std::mutex> guard{mutex_};
+    trace_exporters_.Add(std::forward<E>(exporter));
+  }
+
+  template <typename E> void AddMetricExporter(E &&exporter) {
+    const auto e = std::make_shared<typename std::decay<E>::type>(std::forward<E>(exporter));
+    std::lock_guard<std::mutex> guard{mutex_};
+    metric_exporters_.emplace_back([e](const auto &... args) { (*e)(args...); });
+  }
+
+  // Serves the counters, labeled counters, gauges and histograms of the last drain in the OpenMetrics format from the
+  // collector thread.
+  void ServeOpenMetrics();
+
+  // Drains one last time and joins the collector thread. Called by the destructor if not called before.
+  void Stop();
+
+private:
+  void Run();
+  void Collect();
+
+  TracerImpl &tracer_;
+  MeterImpl &meter_;
+  const std::chrono::milliseconds period_;
+
+  std::mutex mutex_;
+  std::condition_variable wake_up_;
+  bool stop_{false};
+  FanOutExporter trace_exporters_;
+  std::vector<MetricExporter> metric_exporters_;
+  std::unique_ptr<OpenMetricsExporter> open_metrics_;
+
+  std::thread thread_;
+};
+
+} // namespace telemetry
+} // namespace jerryct
+
+#endif // JERRYCT_TELEMETRY_COLLECTOR_H
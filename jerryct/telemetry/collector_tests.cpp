@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/collector.h"
+#include "jerryct/telemetry/counter.h"
+#include "jerryct/telemetry/span.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace jerryct {
+namespace telemetry {
+namespace {
+
+TEST(CollectorTest, WhenStopped_ExpectFinalDrainToAllExporters) {
+  TracerImpl tracer{};
+  MeterImpl meter{};
+  std::size_t events1{0U};
+  std::size_t events2{0U};
+  std::uint64_t count{0U};
+  Collector collector{tracer, meter, std::chrono::hours{1}};
+  collector.AddTraceExporter([&events1](const std::int32_t /*unused*/, const std::uint64_t /*unused*/,
+                                        const Segments<Event> &events, const NameTable & /*unused*/,
+                                        const TimeBase & /*unused*/) { events1 += events.size(); });
+  collector.AddTraceExporter([&events2](const std::int32_t /*unused*/, const std::uint64_t /*unused*/,
+                                        const Segments<Event> &events, const NameTable & /*unused*/,
+                                        const TimeBase & /*unused*/) { events2 += events.size(); });
+  collector.AddMetricExporter([&count](const Measurements<std::uint64_t> &counters) { count = counters.at("foo"); });
+
+  std::thread t{[&tracer, &meter]() {
+    Span s{tracer, "main"};
+    Counter c{meter, "foo"};
+    c.Add(3);
+  }};
+  t.join();
+
+  collector.Stop();
+
+  EXPECT_EQ(2U, events1);
+  EXPECT_EQ(2U, events2);
+  EXPECT_EQ(3U, count);
+}
+
+TEST(CollectorTest, WhenPeriodElapsed_ExpectDrainWithoutStop) {
+  TracerImpl tracer{};
+  MeterImpl meter{};
+  std::atomic<std::size_t> events{0U};
+  Collector collector{tracer, meter, std::chrono::milliseconds{1}};
+  collector.AddTraceExporter([&events](const std::int32_t /*unused*/, const std::uint64_t /*unused*/,
+                                       const Segments<Event> &e, const NameTable & /*unused*/,
+                                       const TimeBase & /*unused*/) { events += e.size(); });
+
+  std::thread t{[&tracer]() { Span s{tracer, "main"}; }};
+  t.join();
+
+  for (std::int32_t i{0}; (i < 1000) && (events != 2U); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+  EXPECT_EQ(2U, events);
+}
+
+} // namespace
+} // namespace telemetry
+} // namespace jerryct
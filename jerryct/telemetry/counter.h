@@ -4,7 +4,6 @@
 #define JERRYCT_TELEMETRY_COUNTER_H
 
 #include "jerryct/string_view.h"
-#include "jerryct/telemetry/fixed_string.h"
 #include "jerryct/telemetry/meter.h"
 #include <cstdint>
 
@@ -20,7 +19,7 @@ public:
 
 private:
   MeterImpl *t_;
-  const FixedString<64> *id_;
+  std::uint32_t id_;
 };
 
 } // namespace telemetry
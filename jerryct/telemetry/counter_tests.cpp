@@ -1,17 +1,24 @@
 // SPDX-License-Identifier: MIT
 
 #include "jerryct/telemetry/counter.h"
-#include <algorithm>
 #include <gtest/gtest.h>
 #include <thread>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace jerryct {
 namespace telemetry {
 namespace {
 
-TEST(CounterTest, WhenCounterCreated_ExpectCounterNameIsRegistered) {
+std::vector<std::pair<string_view, std::uint64_t>> Pairs(const Measurements<std::uint64_t> &data) {
+  std::vector<std::pair<string_view, std::uint64_t>> pairs{};
+  for (const auto &m : data) {
+    pairs.emplace_back(m.name, m.value);
+  }
+  return pairs;
+}
+
+TEST(CounterTest, WhenCounterCreated_ExpectCounterNameIsRegisteredInSortedOrder) {
   MeterImpl meter{};
 
   std::thread t{[&meter]() {
@@ -28,12 +35,11 @@ TEST(CounterTest, WhenCounterCreated_ExpectCounterNameIsRegistered) {
   }};
   t.join();
 
-  meter.Export([](const std::unordered_map<string_view, std::uint64_t> &data) {
-    const std::vector<std::unordered_map<string_view, std::uint64_t>::value_type> expected{
-        std::make_pair(string_view{"measurement_losts"}, 0), std::make_pair(string_view{"foo1"}, 0),
-        std::make_pair(string_view{"foo2"}, 0), std::make_pair(string_view{"bar1"}, 0),
-        std::make_pair(string_view{"bar2"}, 0)};
-    EXPECT_TRUE(std::is_permutation(data.cbegin(), data.cend(), expected.cbegin(), expected.cend()));
+  meter.Export([](const Measurements<std::uint64_t> &data) {
+    const std::vector<std::pair<string_view, std::uint64_t>> expected{
+        std::make_pair(string_view{"bar1"}, 0), std::make_pair(string_view{"bar2"}, 0),
+        std::make_pair(string_view{"foo1"}, 0), std::make_pair(string_view{"foo2"}, 0)};
+    EXPECT_EQ(expected, Pairs(data));
   });
 }
 
@@ -52,10 +58,10 @@ TEST(CounterTest, WhenSingleThreadedCounting_ExpectAccumulatedCount) {
   }};
   t1.join();
 
-  meter.Export([](const std::unordered_map<string_view, std::uint64_t> &data) {
-    const std::vector<std::unordered_map<string_view, std::uint64_t>::value_type> expected{
-        std::make_pair(string_view{"measurement_losts"}, 1), std::make_pair(string_view{"foo"}, 4095)};
-    EXPECT_TRUE(std::is_permutation(data.cbegin(), data.cend(), expected.cbegin(), expected.cend()));
+  meter.Export([](const Measurements<std::uint64_t> &data) {
+    const std::vector<std::pair<string_view, std::uint64_t>> expected{
+        std::make_pair(string_view{"foo"}, 4096)};
+    EXPECT_EQ(expected, Pairs(data));
   });
 }
 
@@ -72,7 +78,7 @@ TEST(CounterTest, WhenSingleThreadedCounting_ExpectAccumulatedCountAcrossMultipl
     }};
     t1.join();
 
-    meter.Export([](const std::unordered_map<string_view, std::uint64_t> &) {});
+    meter.Export([](const Measurements<std::uint64_t> &) {});
 
     std::thread t2{[c = std::move(c)]() mutable {
       for (int i{0}; i < 1000; ++i) {
@@ -83,10 +89,10 @@ TEST(CounterTest, WhenSingleThreadedCounting_ExpectAccumulatedCountAcrossMultipl
   }};
   t.join();
 
-  meter.Export([](const std::unordered_map<string_view, std::uint64_t> &data) {
-    const std::vector<std::unordered_map<string_view, std::uint64_t>::value_type> expected{
-        std::make_pair(string_view{"measurement_losts"}, 0), std::make_pair(string_view{"foo"}, 3000)};
-    EXPECT_TRUE(std::is_permutation(data.cbegin(), data.cend(), expected.cbegin(), expected.cend()));
+  meter.Export([](const Measurements<std::uint64_t> &data) {
+    const std::vector<std::pair<string_view, std::uint64_t>> expected{
+        std::make_pair(string_view{"foo"}, 3000)};
+    EXPECT_EQ(expected, Pairs(data));
   });
 }
 
@@ -111,10 +117,10 @@ TEST(CounterTest, WhenMultiThreadedCounting_ExpectAccumulatedCountAcrossMultiple
   }};
   t.join();
 
-  meter.Export([](const std::unordered_map<string_view, std::uint64_t> &data) {
-    const std::vector<std::unordered_map<string_view, std::uint64_t>::value_type> expected{
-        std::make_pair(string_view{"measurement_losts"}, 3), std::make_pair(string_view{"foo"}, 8190)};
-    EXPECT_TRUE(std::is_permutation(data.cbegin(), data.cend(), expected.cbegin(), expected.cend()));
+  meter.Export([](const Measurements<std::uint64_t> &data) {
+    const std::vector<std::pair<string_view, std::uint64_t>> expected{
+        std::make_pair(string_view{"foo"}, 8193)};
+    EXPECT_EQ(expected, Pairs(data));
   });
 }
 
@@ -139,10 +145,56 @@ TEST(CounterTest, WhenMultipleCountersWithSameName_ExpectAccumulatedCounts) {
   }};
   t.join();
 
-  meter.Export([](const std::unordered_map<string_view, std::uint64_t> &data) {
-    const std::vector<std::unordered_map<string_view, std::uint64_t>::value_type> expected{
-        std::make_pair(string_view{"measurement_losts"}, 0), std::make_pair(string_view{"foo"}, 4000)};
-    EXPECT_TRUE(std::is_permutation(data.cbegin(), data.cend(), expected.cbegin(), expected.cend()));
+  meter.Export([](const Measurements<std::uint64_t> &data) {
+    const std::vector<std::pair<string_view, std::uint64_t>> expected{
+        std::make_pair(string_view{"foo"}, 4000)};
+    EXPECT_EQ(expected, Pairs(data));
+  });
+}
+
+TEST(CounterTest, WhenHotCounter_ExpectNoLostIncrements) {
+  MeterImpl meter{};
+
+  std::thread t{[&meter]() {
+    Counter c{meter, "foo"};
+    Counter d{meter, "bar"};
+    for (int i{0}; i < 1000000; ++i) {
+      c.Add();
+      d.Add(2);
+    }
+  }};
+  t.join();
+
+  meter.Export([](const Measurements<std::uint64_t> &data) {
+    const std::vector<std::pair<string_view, std::uint64_t>> expected{
+        std::make_pair(string_view{"bar"}, 2000000), std::make_pair(string_view{"foo"}, 1000000)};
+    EXPECT_EQ(expected, Pairs(data));
+  });
+}
+
+TEST(CounterTest, WhenNamesRegisteredBetweenExports_ExpectSortedOrder) {
+  MeterImpl meter{};
+
+  std::thread t1{[&meter]() {
+    const Counter d{meter, "d"};
+    const Counter b{meter, "b"};
+  }};
+  t1.join();
+  meter.Export([](const Measurements<std::uint64_t> &) {});
+
+  std::thread t2{[&meter]() {
+    const Counter c{meter, "c"};
+    const Counter a{meter, "a"};
+    const Counter e{meter, "e"};
+  }};
+  t2.join();
+
+  meter.Export([](const Measurements<std::uint64_t> &data) {
+    const std::vector<std::pair<string_view, std::uint64_t>> expected{
+        std::make_pair(string_view{"a"}, 0), std::make_pair(string_view{"b"}, 0), std::make_pair(string_view{"c"}, 0),
+        std::make_pair(string_view{"d"}, 0), std::make_pair(string_view{"e"}, 0)};
+    EXPECT_EQ(expected, Pairs(data));
+    EXPECT_EQ(nullptr, data.Find("f"));
   });
 }
 
@@ -10,18 +10,23 @@ namespace telemetry {
 DeltaCounterExporter::DeltaCounterExporter() { Reset(); }
 
 void DeltaCounterExporter::Reset() {
-  Meter().Export([this](const std::unordered_map<jerryct::string_view, std::uint64_t> &counters) { init_ = counters; });
+  Meter().Export([this](const Measurements<std::uint64_t> &counters) {
+    init_.clear();
+    for (const auto &c : counters) {
+      init_[c.name] = c.value;
+    }
+  });
 }
 
 std::uint64_t DeltaCounterExporter::Get(const jerryct::string_view name) {
   bool found = false;
   std::uint64_t value = 0;
 
-  Meter().Export([this, name, &found, &value](const std::unordered_map<jerryct::string_view, std::uint64_t> &counters) {
-    const auto it = counters.find(name);
-    if (it != counters.end()) {
+  Meter().Export([this, name, &found, &value](const Measurements<std::uint64_t> &counters) {
+    const std::uint64_t *const v{counters.Find(name)};
+    if (v != nullptr) {
       found = true;
-      value = it->second - init_[name];
+      value = *v - init_[name];
     }
   });
 
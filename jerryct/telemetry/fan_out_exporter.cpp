@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/fan_out_exporter.h"
+
+namespace jerryct {
+namespace telemetry {
+
+FanOutExporter::FanOutExporter(const Execution execution) : execution_{execution} {}
+
+FanOutExporter::~FanOutExporter() noexcept {
+  {
+    std::lock_guard<std::mutex> guard{mutex_};
+    stop_ = true;
+  }
+  batch_ready_.notify_all();
+  for (auto &s : sinks_) {
+    if (s->thread.joinable()) {
+      s->thread.join();
+    }
+  }
+}
+
+void FanOutExporter::Add(Exporter exporter) {
+  sinks_.emplace_back(new Sink{std::move(exporter), std::thread{}});
+  if (execution_ == Execution::parallel) {
+    Sink &sink{*sinks_.back()};
+    const std::uint64_t generation{generation_};
+    sink.thread = std::thread{[this, &sink, generation]() { Run(sink, generation); }};
+  }
+}
+
+void FanOutExporter::operator()(const std::int32_t tid, const std::uint64_t losts, const Segments<Event> &events,
+                                const NameTable &names, const TimeBase &time_base) {
+  if (execution_ == Execution::sequential) {
+    for (auto &s : sinks_) {
+      s->exporter(tid, losts, events, names, time_base);
+    }
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock{mutex_};
+  batch_ = Batch{tid, losts, &events, &names, &time_base};
+  pending_ = sinks_.size();
+  ++generation_;
+  batch_ready_.notify_all();
+  batch_done_.wait(lock, [this]() { return pending_ == 0U; });
+}
+
+void FanOutExporter::Run(Sink &sink, std::uint64_t seen) {
+  std::unique_lock<std::mutex> lock{mutex_};
+  for (;;) {
+    batch_ready_.wait(lock, [this, seen]() { return stop_ || (generation_ != seen); });
+    if (stop_) {
+      return;
+    }
+    seen = generation_;
+    const Batch batch{batch_};
+
+    lock.unlock();
+    sink.exporter(batch.tid, batch.losts, *batch.events, *batch.names, *batch.time_base);
+    lock.lock();
+
+    --pending_;
+    if (pending_ == 0U) {
+      batch_done_.notify_one();
+    }
+  }
+}
+
+} // namespace telemetry
+} // namespace jerryct
@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: MIT
+
+#ifndef JERRYCT_TELEMETRY_FAN_OUT_EXPORTER_H
+#define JERRYCT_TELEMETRY_FAN_OUT_EXPORTER_H
+
+#include "jerryct/telemetry/tracer.h"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jerryct {
+namespace telemetry {
+
+// Hands each drained batch of events to several exporters, so one drain serves e.g. stats and a Chrome trace. The
+// batch is released only after all exporters returned.
+//
+// sequential calls the exporters one after the other on the draining thread. parallel gives each exporter its own
+// thread; an exporter is always called from the same thread, so exporters need not be thread-safe.
+class FanOutExporter {
+public:
+  using Exporter = std::function<void(const std::int32_t, const std::uint64_t, const Segments<Event> &,
+                                      const NameTable &, const TimeBase &)>;
+
+  enum class Execution : std::int32_t { sequential, parallel };
+
+  explicit FanOutExporter(const Execution execution = Execution::sequential);
+  FanOutExporter(const FanOutExporter &) = delete;
+  FanOutExporter(FanOutExporter &&) = delete;
+  FanOutExporter &operator=(const FanOutExporter &) = delete;
+  FanOutExporter &operator=(FanOutExporter &&) = delete;
+  ~FanOutExporter() noexcept;
+
+  // Takes ownership of the exporter. Must not be called concurrently with exporting.
+  template <typename E> void Add(E &&exporter) {
+    const auto e = std::make_shared<typename std::decay<E>::type>(std::forward<E>(exporter));
+    Add(Exporter{[e](const auto &... args) { (*e)(args...); }});
+  }
+  void Add(Exporter exporter);
+
+  bool Empty() const noexcept { return sinks_.empty(); }
+
+  void operator()(const std::int32_t tid, const std::uint64_t losts, const Segments<Event> &events,
+                  const NameTable &names, const TimeBase &time_base);
+
+private:
+  struct Sink {
+    Exporter exporter;
+    std::thread thread;
+  };
+
+  struct Batch {
+    std::int32_t tid;
+    std::uint64_t losts;
+    const Segments<Event> *events;
+    const NameTable *names;
+    const TimeBase *time_base;
+  };
+
+  void Run(Sink &sink, std::uint64_t seen);
+
+  const Execution execution_;
+  std::vector<std::unique_ptr<Sink>> sinks_;
+
+  std::mutex mutex_;
+  std::condition_variable batch_ready_;
+  std::condition_variable batch_done_;
+  std::uint64_t generation_{0U};
+  std::size_t pending_{0U};
+  bool stop_{false};
+  Batch batch_{};
+};
+
+} // namespace telemetry
+} // namespace jerryct
+
+#endif // JERRYCT_TELEMETRY_FAN_OUT_EXPORTER_H
@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/fan_out_exporter.h"
+#include "jerryct/telemetry/span.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace jerryct {
+namespace telemetry {
+namespace {
+
+class Sink {
+public:
+  explicit Sink(std::vector<std::size_t> &sizes) : sizes_{&sizes} {}
+
+  void operator()(const std::int32_t /*unused*/, const std::uint64_t /*unused*/, const Segments<Event> &events,
+                  const NameTable & /*unused*/, const TimeBase & /*unused*/) {
+    sizes_->push_back(events.size());
+  }
+
+private:
+  std::vector<std::size_t> *sizes_;
+};
+
+void ExpectSameBatchForAllSinks(const FanOutExporter::Execution execution) {
+  TracerImpl tracer{};
+
+  std::thread t{[&tracer]() {
+    Span s1{tracer, "main"};
+    Span s2{tracer, "foo"};
+  }};
+  t.join();
+
+  std::vector<std::size_t> sizes1{};
+  std::vector<std::size_t> sizes2{};
+  std::vector<std::size_t> sizes3{};
+  {
+    FanOutExporter fan_out{execution};
+    fan_out.Add(Sink{sizes1});
+    fan_out.Add(Sink{sizes2});
+    fan_out.Add(Sink{sizes3});
+
+    tracer.Export(fan_out);
+    tracer.Export(fan_out);
+  }
+
+  EXPECT_EQ(std::vector<std::size_t>{4U}, sizes1);
+  EXPECT_EQ(std::vector<std::size_t>{4U}, sizes2);
+  EXPECT_EQ(std::vector<std::size_t>{4U}, sizes3);
+}
+
+TEST(FanOutExporterTest, WhenSequential_ExpectSameBatchForAllSinks) {
+  ExpectSameBatchForAllSinks(FanOutExporter::Execution::sequential);
+}
+
+TEST(FanOutExporterTest, WhenParallel_ExpectSameBatchForAllSinks) {
+  ExpectSameBatchForAllSinks(FanOutExporter::Execution::parallel);
+}
+
+TEST(FanOutExporterTest, WhenParallel_ExpectSinksCalledFromOwnThread) {
+  TracerImpl tracer{};
+
+  std::thread t{[&tracer]() { Span s{tracer, "main"}; }};
+  t.join();
+
+  std::vector<std::thread::id> ids{};
+  {
+    FanOutExporter fan_out{FanOutExporter::Execution::parallel};
+    fan_out.Add([&ids](const std::int32_t /*unused*/, const std::uint64_t /*unused*/,
+                       const Segments<Event> & /*unused*/, const NameTable & /*unused*/,
+                       const TimeBase & /*unused*/) { ids.push_back(std::this_thread::get_id()); });
+
+    tracer.Export(fan_out);
+  }
+
+  ASSERT_EQ(1U, ids.size());
+  EXPECT_NE(std::this_thread::get_id(), ids[0U]);
+}
+
+} // namespace
+} // namespace telemetry
+} // namespace jerryct
@@ -0,0 +1,272 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/file_sink.h"
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace jerryct {
+namespace telemetry {
+
+namespace {
+
+std::error_code ErrorCode(const int error) noexcept {
+  return error == 0 ? std::error_code{} : std::error_code{error, std::generic_category()};
+}
+
+// Alignment of buffers, sizes and file offsets as required by O_DIRECT.
+constexpr std::size_t alignment{4096U};
+
+struct Free {
+  void operator()(char *const p) const noexcept { std::free(p); }
+};
+
+struct Buffer {
+  std::unique_ptr<char, Free> data;
+  std::size_t size;
+};
+
+// Returns the errno of a failed write, 0 on success.
+int WriteAll(const int fd, const char *data, std::size_t size) noexcept {
+  while (size != 0U) {
+    const ssize_t n{::write(fd, data, size)};
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return errno;
+    }
+    data += n;
+    size -= static_cast<std::size_t>(n);
+  }
+  return 0;
+}
+
+// Owns a file descriptor, so that it is closed if constructing the writer fails halfway.
+class Descriptor {
+public:
+  explicit Descriptor(const int fd) noexcept : fd_{fd} {}
+  Descriptor(const Descriptor &) = delete;
+  Descriptor(Descriptor &&) = delete;
+  Descriptor &operator=(const Descriptor &) = delete;
+  Descriptor &operator=(Descriptor &&) = delete;
+  ~Descriptor() noexcept {
+    if (fd_ != -1) {
+      static_cast<void>(Close());
+    }
+  }
+
+  int Get() const noexcept { return fd_; }
+
+  // Returns the errno of a failed close, 0 on success.
+  int Close() noexcept {
+    const int result{::close(fd_)};
+    fd_ = -1;
+    return result == 0 ? 0 : errno;
+  }
+
+private:
+  int fd_;
+};
+
+int Open(const std::string &filename, const bool direct) {
+  const int flags{O_CREAT | O_WRONLY | O_TRUNC | O_CLOEXEC};
+  if (direct) {
+    const int fd{::open(filename.c_str(), flags | O_DIRECT, 0644)};
+    if ((fd != -1) || (errno != EINVAL)) {
+      return fd;
+    }
+  }
+  return ::open(filename.c_str(), flags, 0644);
+}
+
+} // namespace
+
+class FileSink::Writer {
+public:
+  Writer(const std::string &filename, const FileSinkOptions &options)
+      : fd_{Open(filename, options.direct)},
+        capacity_{std::max(alignment, (options.buffer_size + alignment - 1U) / alignment * alignment)},
+        max_buffers_{std::max({options.max_buffers, options.buffers, std::size_t{2U}})} {
+    if (fd_.Get() == -1) {
+      throw std::system_error{errno, std::generic_category(), "cannot open " + filename};
+    }
+    direct_ = (::fcntl(fd_.Get(), F_GETFL) & O_DIRECT) != 0;
+    if (options.preallocate != 0U) {
+      // Best effort: without support the file just grows on demand.
+      static_cast<void>(::fallocate(fd_.Get(), FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(options.preallocate)));
+    }
+
+    current_ = Allocate();
+    for (std::size_t i{1U}; i < options.buffers; ++i) {
+      free_.push_back(Allocate());
+    }
+    thread_ = std::thread{[this]() { Run(); }};
+  }
+
+  Writer(const Writer &) = delete;
+  Writer(Writer &&) = delete;
+  Writer &operator=(const Writer &) = delete;
+  Writer &operator=(Writer &&) = delete;
+
+  ~Writer() noexcept {
+    if (fd_.Get() != -1) {
+      static_cast<void>(Finish());
+    }
+  }
+
+  // Writes the remaining data, joins the writer thread and closes the file. Returns the first error.
+  int Finish() noexcept {
+    {
+      std::lock_guard<std::mutex> guard{mutex_};
+      stop_ = true;
+    }
+    ready_.notify_one();
+    thread_.join();
+
+    // The tail is not a multiple of the alignment, hence it is written through the page cache.
+    if (direct_ && (current_.size != 0U)) {
+      static_cast<void>(::fcntl(fd_.Get(), F_SETFL, ::fcntl(fd_.Get(), F_GETFL) & ~O_DIRECT));
+    }
+    if (error_ == 0) {
+      error_ = WriteAll(fd_.Get(), current_.data.get(), current_.size);
+    }
+    const int error{fd_.Close()};
+    if (error_ == 0) {
+      error_ = error;
+    }
+    return error_;
+  }
+
+  int Error() {
+    std::lock_guard<std::mutex> guard{mutex_};
+    return error_;
+  }
+
+  void Write(const char *data, std::size_t size) {
+    while (size != 0U) {
+      const std::size_t n{std::min(size, capacity_ - current_.size)};
+      std::memcpy(current_.data.get() + current_.size, data, n);
+      current_.size += n;
+      data += n;
+      size -= n;
+      if (current_.size == capacity_) {
+        Submit();
+      }
+    }
+  }
+
+private:
+  Buffer Allocate() {
+    char *const memory{static_cast<char *>(::aligned_alloc(alignment, capacity_))};
+    if (memory == nullptr) {
+      throw std::bad_alloc{};
+    }
+    ++allocated_;
+    return Buffer{std::unique_ptr<char, Free>{memory}, 0U};
+  }
+
+  // Hands the full buffer to the writer thread and continues with a free one. Allocates another buffer rather than
+  // waiting for the disk if none is free, unless max_buffers are allocated already.
+  void Submit() {
+    Buffer next{};
+    {
+      std::unique_lock<std::mutex> lock{mutex_};
+      full_.push_back(std::move(current_));
+      ready_.notify_one();
+      if (free_.empty() && (allocated_ >= max_buffers_)) {
+        written_.wait(lock, [this]() { return !free_.empty(); });
+      }
+      if (!free_.empty()) {
+        next = std::move(free_.back());
+        free_.pop_back();
+      }
+    }
+    current_ = next.data ? std::move(next) : Allocate();
+  }
+
+  void Run() {
+    std::unique_lock<std::mutex> lock{mutex_};
+    for (;;) {
+      ready_.wait(lock, [this]() { return stop_ || !full_.empty(); });
+      if (full_.empty()) {
+        return;
+      }
+      Buffer b{std::move(full_.front())};
+      full_.pop_front();
+
+      const bool failed{error_ != 0};
+      lock.unlock();
+      const int error{failed ? 0 : WriteAll(fd_.Get(), b.data.get(), b.size)};
+      lock.lock();
+
+      if (error != 0) {
+        error_ = error;
+      }
+      b.size = 0U;
+      free_.push_back(std::move(b));
+      written_.notify_one();
+    }
+  }
+
+  Descriptor fd_;
+  const std::size_t capacity_;
+  const std::size_t max_buffers_;
+  std::size_t allocated_{0U};
+  bool direct_{false};
+  Buffer current_{};
+
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  std::condition_variable written_;
+  std::deque<Buffer> full_;
+  std::vector<Buffer> free_;
+  bool stop_{false};
+  int error_{0};
+
+  std::thread thread_;
+};
+
+FileSink::FileSink() noexcept = default;
+
+FileSink::FileSink(const std::string &filename, const FileSinkOptions &options)
+    : writer_{new Writer{filename, options}} {}
+
+FileSink::FileSink(FileSink &&other) noexcept = default;
+
+FileSink &FileSink::operator=(FileSink &&other) noexcept = default;
+
+FileSink::~FileSink() noexcept = default;
+
+void FileSink::Write(const void *data, const std::size_t size) {
+  if (writer_ == nullptr) {
+    if (!error_) {
+      error_ = std::make_error_code(std::errc::bad_file_descriptor);
+    }
+    return;
+  }
+  writer_->Write(static_cast<const char *>(data), size);
+}
+
+std::error_code FileSink::Error() const noexcept { return writer_ != nullptr ? ErrorCode(writer_->Error()) : error_; }
+
+void FileSink::Close() noexcept {
+  if (writer_ != nullptr) {
+    error_ = ErrorCode(writer_->Finish());
+    writer_.reset();
+  }
+}
+
+} // namespace telemetry
+} // namespace jerryct
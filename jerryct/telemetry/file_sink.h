@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: MIT
+
+#ifndef JERRYCT_TELEMETRY_FILE_SINK_H
+#define JERRYCT_TELEMETRY_FILE_SINK_H
+
+#include "jerryct/string_view.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <system_error>
+
+namespace jerryct {
+namespace telemetry {
+
+struct FileSinkOptions {
+  // Size of each buffer, rounded up to a multiple of 4096 bytes.
+  std::size_t buffer_size{1U << 20U};
+  // Buffers allocated up front. While the disk falls behind further buffers are allocated instead of waiting, up to
+  // max_buffers.
+  std::size_t buffers{2U};
+  // Bypasses the page cache with O_DIRECT. Falls back to buffered I/O if the file system does not support it.
+  bool direct{false};
+  // Bytes reserved on disk up front, so that a growing file does not stall on block allocation.
+  std::uint64_t preallocate{0U};
+  // Bounds the memory held for a stalled disk. Once all buffers are full, Write() waits for the disk; a tracer drained
+  // by the caller meanwhile drops and counts events in its queues, which keeps the file itself intact.
+  std::size_t max_buffers{16U};
+};
+
+// Writes a file from a dedicated writer thread. Write() only copies into the current buffer; a full buffer is handed
+// to the writer thread and filling continues in the next free one. Hence a disk stall only blocks the caller, e.g. the
+// thread draining the tracer, once max_buffers are full. The data is written in order and completely on Close() or
+// destruction, unless writing fails: the first error, e.g. ENOSPC or EIO, stops all further writes and is kept by
+// Error().
+class FileSink {
+public:
+  // A closed sink.
+  FileSink() noexcept;
+  // Throws std::system_error if the file cannot be opened.
+  explicit FileSink(const std::string &filename, const FileSinkOptions &options = {});
+  FileSink(const FileSink &) = delete;
+  FileSink &operator=(const FileSink &) = delete;
+  FileSink(FileSink &&other) noexcept;
+  FileSink &operator=(FileSink &&other) noexcept;
+  ~FileSink() noexcept;
+
+  bool IsOpen() const noexcept { return writer_ != nullptr; }
+  // The first error writing the file, also after Close(). Data written after it is discarded.
+  std::error_code Error() const noexcept;
+
+  // Writing to a closed or moved-from sink discards the data and sets Error() to EBADF unless set already.
+  void Write(const void *data, const std::size_t size);
+  void Write(const string_view s) { Write(s.data(), s.size()); }
+
+  // Writes the remaining data, joins the writer thread and closes the file.
+  void Close() noexcept;
+
+private:
+  class Writer;
+  std::unique_ptr<Writer> writer_;
+  std::error_code error_{};
+};
+
+} // namespace telemetry
+} // namespace jerryct
+
+#endif // JERRYCT_TELEMETRY_FILE_SINK_H
@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/file_sink.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <new>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace jerryct {
+namespace telemetry {
+namespace {
+
+std::string Read(const std::string &filename) {
+  std::ifstream i{filename, std::ios::binary};
+  const std::string content{std::istreambuf_iterator<char>{i}, {}};
+  std::remove(filename.c_str());
+  return content;
+}
+
+std::string Lines() {
+  std::string lines{};
+  for (std::int32_t i{0}; i < 10000; ++i) {
+    lines += "line " + std::to_string(i) + "\n";
+  }
+  return lines;
+}
+
+void WriteLines(FileSink &sink) {
+  for (std::int32_t i{0}; i < 10000; ++i) {
+    sink.Write("line " + std::to_string(i) + "\n");
+  }
+}
+
+TEST(FileSinkTest, WhenWritingMoreThanAllBuffers_ExpectCompleteFileInOrder) {
+  {
+    FileSink sink{"test.sink", FileSinkOptions{4096U, 2U, false, 0U}};
+    WriteLines(sink);
+  }
+
+  EXPECT_EQ(Lines(), Read("test.sink"));
+}
+
+TEST(FileSinkTest, WhenDirect_ExpectCompleteFileInOrder) {
+  {
+    FileSink sink{"test.sink", FileSinkOptions{4096U, 2U, true, 0U}};
+    WriteLines(sink);
+  }
+
+  EXPECT_EQ(Lines(), Read("test.sink"));
+}
+
+TEST(FileSinkTest, WhenPreallocated_ExpectOnlyWrittenSize) {
+  {
+    FileSink sink{"test.sink", FileSinkOptions{4096U, 2U, false, 1U << 20U}};
+    sink.Write("abc");
+  }
+
+  EXPECT_EQ("abc", Read("test.sink"));
+}
+
+TEST(FileSinkTest, WhenClosed_ExpectDataWritten) {
+  FileSink sink{"test.sink"};
+  sink.Write("abc");
+  sink.Close();
+
+  EXPECT_FALSE(sink.IsOpen());
+  EXPECT_EQ("abc", Read("test.sink"));
+}
+
+TEST(FileSinkTest, WhenMoved_ExpectOnlyTargetOpen) {
+  FileSink sink{"test.sink"};
+  FileSink other{std::move(sink)};
+  other.Write("abc");
+  other.Close();
+
+  EXPECT_FALSE(sink.IsOpen());
+  EXPECT_EQ("abc", Read("test.sink"));
+}
+
+TEST(FileSinkTest, WhenAllBuffersFull_ExpectWriteWaitsForDisk) {
+  ASSERT_EQ(0, ::mkfifo("test.fifo", 0600));
+  const int reader{::open("test.fifo", O_RDONLY | O_NONBLOCK)};
+  FileSink sink{"test.fifo", FileSinkOptions{4096U, 2U, false, 0U, 2U}};
+
+  const std::string data(1U << 20U, 'x');
+  std::atomic<bool> written{false};
+  std::thread t{[&sink, &data, &written]() {
+    sink.Write(data);
+    written = true;
+  }};
+  std::this_thread::sleep_for(std::chrono::milliseconds{100});
+  EXPECT_FALSE(written);
+
+  std::size_t size{0U};
+  char buf[4096];
+  while (size < data.size()) {
+    const ssize_t n{::read(reader, buf, sizeof(buf))};
+    if (n > 0) {
+      size += static_cast<std::size_t>(n);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  t.join();
+  sink.Close();
+  ::close(reader);
+  std::remove("test.fifo");
+
+  EXPECT_TRUE(written);
+  EXPECT_FALSE(sink.Error());
+}
+
+TEST(FileSinkTest, WhenWriteFails_ExpectError) {
+  FileSink sink{"/dev/full", FileSinkOptions{4096U, 2U, false, 0U}};
+  sink.Write(std::string(3U * 4096U, 'x'));
+  sink.Write("abc");
+  sink.Close();
+
+  EXPECT_EQ(std::make_error_code(std::errc::no_space_on_device), sink.Error());
+}
+
+TEST(FileSinkTest, WhenWrittenAfterClose_ExpectBadFileDescriptor) {
+  FileSink sink{"test.sink"};
+  sink.Write("abc");
+  sink.Close();
+  sink.Write("def");
+
+  EXPECT_EQ(std::make_error_code(std::errc::bad_file_descriptor), sink.Error());
+  EXPECT_EQ("abc", Read("test.sink"));
+}
+
+TEST(FileSinkTest, WhenWrittenAfterMove_ExpectBadFileDescriptor) {
+  FileSink sink{"test.sink"};
+  FileSink other{std::move(sink)};
+  sink.Write("abc");
+  other.Close();
+
+  EXPECT_EQ(std::make_error_code(std::errc::bad_file_descriptor), sink.Error());
+  EXPECT_FALSE(other.Error());
+  EXPECT_EQ("", Read("test.sink"));
+}
+
+TEST(FileSinkTest, WhenBufferAllocationFails_ExpectFileClosed) {
+  const int before{::open("/dev/null", O_RDONLY)};
+  ::close(before);
+
+  EXPECT_THROW((FileSink{"test.sink", FileSinkOptions{std::size_t{1U} << 62U}}), std::bad_alloc);
+
+  const int after{::open("/dev/null", O_RDONLY)};
+  ::close(after);
+  EXPECT_EQ(before, after);
+  std::remove("test.sink");
+}
+
+TEST(FileSinkTest, WhenDirectoryMissing_ExpectSystemError) {
+  EXPECT_THROW(FileSink{"missing/test.sink"}, std::system_error);
+}
+
+} // namespace
+} // namespace telemetry
+} // namespace jerryct
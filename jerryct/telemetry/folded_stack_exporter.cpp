@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/folded_stack_exporter.h"
+#include "jerryct/telemetry/file_sink.h"
+#include <cerrno>
+#include <cstdio>
+#include <fmt/format.h>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace jerryct {
+namespace telemetry {
+
+FoldedStackExporter::FoldedStackExporter(std::string filename) : tree_{}, total_{}, filename_{std::move(filename)} {}
+
+FoldedStackExporter::~FoldedStackExporter() noexcept {
+  if (!filename_.empty()) {
+    try {
+      Flush();
+      Write();
+    } catch (...) {
+      // The last totals are lost; a destructor cannot report the error.
+    }
+  }
+}
+
+void FoldedStackExporter::operator()(const std::int32_t tid, const std::uint64_t /*unused*/,
+                                     const Segments<Event> &events, const NameTable &names,
+                                     const TimeBase &time_base) {
+  tree_(tid, events, names, time_base);
+}
+
+void FoldedStackExporter::Write() {
+  total_.Merge(tree_.TakeWindow());
+
+  // Stack of each node; parents precede their children.
+  std::vector<std::string> stacks(total_.nodes.size());
+  fmt::memory_buffer buf{};
+  for (std::size_t i{1U}; i < total_.nodes.size(); ++i) {
+    const CallTree::Node &n{total_.nodes[i]};
+    std::string &stack{stacks[i]};
+    if (n.parent != 0U) {
+      stack = stacks[n.parent];
+      stack += ';';
+    }
+    for (const char c : tree_.Label(n.name)) {
+      stack += ((c == ';') || (c == '\n') || (c == '\r')) ? '_' : c;
+    }
+
+    if (n.self.count() > 0) {
+      buf.append(stack.data(), stack.data() + stack.size());
+      buf.push_back(' ');
+      buf.append(fmt::format_int{n.self.count()});
+      buf.push_back('\n');
+    }
+  }
+
+  // Replaces the file only once completely written, so readers never see a partial file.
+  const std::string tmp{filename_ + ".tmp"};
+  FileSink f{tmp};
+  f.Write(buf.data(), buf.size());
+  f.Close();
+  if (f.Error()) {
+    std::remove(tmp.c_str());
+    throw std::system_error{f.Error(), "cannot write " + tmp};
+  }
+  if (std::rename(tmp.c_str(), filename_.c_str()) != 0) {
+    const int error{errno};
+    std::remove(tmp.c_str());
+    throw std::system_error{error, std::generic_category(), "cannot rename " + tmp + " to " + filename_};
+  }
+}
+
+} // namespace telemetry
+} // namespace jerryct
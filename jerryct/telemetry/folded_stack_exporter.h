@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: MIT
+
+#ifndef JERRYCT_TELEMETRY_FOLDED_STACK_EXPORTER_H
+#define JERRYCT_TELEMETRY_FOLDED_STACK_EXPORTER_H
+
+#include "jerryct/telemetry/call_tree.h"
+#include "jerryct/telemetry/tracer.h"
+#include <cstdint>
+#include <string>
+
+namespace jerryct {
+namespace telemetry {
+
+// Writes the self time per stack of spans in nanoseconds in the folded format read by flamegraph.pl and speedscope,
+// e.g. "main;Foo;Baz 123456", one line per distinct stack. The times accumulate over the whole run and Write()
+// rewrites the file, hence its size follows the number of distinct stacks instead of the number of events. ';' and
+// line breaks in names are replaced by '_'.
+class FoldedStackExporter {
+public:
+  explicit FoldedStackExporter(std::string filename);
+  FoldedStackExporter(const FoldedStackExporter &) = delete;
+  FoldedStackExporter(FoldedStackExporter &&other) noexcept = default;
+  FoldedStackExporter &operator=(const FoldedStackExporter &) = delete;
+  FoldedStackExporter &operator=(FoldedStackExporter &&other) noexcept = default;
+  // Writes the file a last time, including spans whose parent never arrived; errors are ignored.
+  ~FoldedStackExporter() noexcept;
+
+  void operator()(const std::int32_t tid, const std::uint64_t /*unused*/, const Segments<Event> &events,
+                  const NameTable &names, const TimeBase &time_base);
+
+  // Writes filename.tmp and renames it to filename. Throws std::system_error if either fails, leaving filename as it
+  // was. Completed spans still waiting for their parent are written by a later call, see CallTree.
+  void Write();
+
+  // Gives up waiting for the parents of completed spans, e.g. once the traced program finished, see CallTree::Flush().
+  void Flush() { tree_.Flush(); }
+
+private:
+  CallTree tree_;
+  CallTree::Tree total_;
+  std::string filename_;
+};
+
+} // namespace telemetry
+} // namespace jerryct
+
+#endif // JERRYCT_TELEMETRY_FOLDED_STACK_EXPORTER_H
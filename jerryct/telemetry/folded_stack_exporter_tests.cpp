@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/folded_stack_exporter.h"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace jerryct {
+namespace telemetry {
+namespace {
+
+class FoldedStackExporterTest : public testing::Test {
+protected:
+  FoldedStackExporterTest() {
+    names_.Register("");
+    names_.Register("main");
+    names_.Register("Foo");
+    names_.Register("Baz");
+    names_.Register("a;b\nc");
+  }
+
+  ~FoldedStackExporterTest() override { std::remove("test.folded"); }
+
+  void Export(FoldedStackExporter &folded, const std::int32_t tid, const std::vector<Event> &events) {
+    folded(tid, 0U, Segments<Event>{Segment<Event>{events.data(), events.data() + events.size()}}, names_,
+           TimeBase{});
+  }
+
+  static std::string Read() {
+    std::ifstream i{"test.folded"};
+    return {std::istreambuf_iterator<char>{i}, {}};
+  }
+
+  NameTable names_{};
+};
+
+TEST_F(FoldedStackExporterTest, WhenNested_ExpectSelfTimePerStack) {
+  {
+    FoldedStackExporter folded{"test.folded"};
+    Export(folded, 0, {Event{Phase::begin, 1U, 0U, 0}, Event{Phase::begin, 2U, 0U, 10}, Event{Phase::begin, 3U, 0U, 20},
+                       Event{Phase::end, 0U, 0U, 50}, Event{Phase::end, 0U, 0U, 60}, Event{Phase::complete, 3U, 5U, 70},
+                       Event{Phase::end, 0U, 0U, 100}});
+  }
+
+  EXPECT_EQ("main 45\nmain;Foo 20\nmain;Foo;Baz 30\nmain;Baz 5\n", Read());
+}
+
+TEST_F(FoldedStackExporterTest, WhenSiblingsStartAtSameTick_ExpectNotNested) {
+  FoldedStackExporter folded{"test.folded"};
+  Export(folded, 0, {Event{Phase::complete, 3U, 0U, 10}, Event{Phase::complete, 2U, 5U, 10},
+                     Event{Phase::complete, 1U, 100U, 0}});
+  folded.Flush();
+  folded.Write();
+
+  EXPECT_EQ("main 95\nmain;Foo 5\n", Read());
+}
+
+TEST_F(FoldedStackExporterTest, WhenWrittenRepeatedly_ExpectTotalsOverWholeRun) {
+  FoldedStackExporter folded{"test.folded"};
+  Export(folded, 0, {Event{Phase::complete, 2U, 10U, 0}});
+  folded.Flush();
+  folded.Write();
+  Export(folded, 1, {Event{Phase::complete, 2U, 20U, 0}});
+  Export(folded, 0, {Event{Phase::complete, 2U, 30U, 100}});
+  folded.Flush();
+  folded.Write();
+
+  EXPECT_EQ("Foo 60\n", Read());
+}
+
+TEST_F(FoldedStackExporterTest, WhenWrittenWhileParentOpen_ExpectChildrenWrittenBelowParent) {
+  FoldedStackExporter folded{"test.folded"};
+  Export(folded, 0, {Event{Phase::complete, 2U, 20U, 10}, Event{Phase::complete, 3U, 5U, 40}});
+  folded.Write();
+  EXPECT_EQ("", Read());
+  Export(folded, 0, {Event{Phase::complete, 1U, 100U, 0}});
+  folded.Flush();
+  folded.Write();
+
+  EXPECT_EQ("main 75\nmain;Baz 5\nmain;Foo 20\n", Read());
+}
+
+TEST_F(FoldedStackExporterTest, WhenSeparatorInName_ExpectReplaced) {
+  FoldedStackExporter folded{"test.folded"};
+  Export(folded, 0, {Event{Phase::complete, 4U, 10U, 0}});
+  folded.Flush();
+  folded.Write();
+
+  EXPECT_EQ("a_b_c 10\n", Read());
+}
+
+TEST_F(FoldedStackExporterTest, WhenWriteFails_ExpectThrownAndDestructorNotTerminating) {
+  FoldedStackExporter folded{"missing/test.folded"};
+  Export(folded, 0, {Event{Phase::complete, 2U, 10U, 0}});
+
+  EXPECT_THROW(folded.Write(), std::system_error);
+}
+
+TEST_F(FoldedStackExporterTest, WhenWritten_ExpectNoTemporaryFileLeft) {
+  {
+    FoldedStackExporter folded{"test.folded"};
+    Export(folded, 0, {Event{Phase::complete, 2U, 10U, 0}});
+  }
+
+  EXPECT_EQ("Foo 10\n", Read());
+  EXPECT_FALSE(std::ifstream{"test.folded.tmp"}.is_open());
+}
+
+} // namespace
+} // namespace telemetry
+} // namespace jerryct
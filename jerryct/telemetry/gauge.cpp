@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/gauge.h"
+#include "jerryct/telemetry/clock.h"
+
+namespace jerryct {
+namespace telemetry {
+
+Gauge::Gauge(MeterImpl &t, const jerryct::string_view name) : t_{&t}, id_{t_->RegisterGauge(name)} {}
+
+void Gauge::Set(const std::int64_t v) {
+  t_->PerThreadGauges()->Set(id_, v, Now(Clock::steady), t_->LastGaugeSet(id_));
+}
+void Gauge::Add(const std::int64_t v) { t_->PerThreadGauges()->Add(id_, v, t_->LastGaugeSet(id_)); }
+void Gauge::Increment() { Add(1); }
+void Gauge::Decrement() { Add(-1); }
+
+} // namespace telemetry
+} // namespace jerryct
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: MIT
+
+#ifndef JERRYCT_TELEMETRY_GAUGE_H
+#define JERRYCT_TELEMETRY_GAUGE_H
+
+#include "jerryct/string_view.h"
+#include "jerryct/telemetry/meter.h"
+#include <cstdint>
+
+namespace jerryct {
+namespace telemetry {
+
+// Current value like a queue depth or the number of in-flight requests. Set() overrides the value, Add() changes it by
+// a signed delta. Both only write to per-thread slots, so threads never contend.
+class Gauge final {
+public:
+  Gauge(MeterImpl &t, const jerryct::string_view name);
+
+  void Set(const std::int64_t v);
+  void Add(const std::int64_t v);
+  void Increment();
+  void Decrement();
+
+private:
+  MeterImpl *t_;
+  std::uint32_t id_;
+};
+
+} // namespace telemetry
+} // namespace jerryct
+
+#endif // JERRYCT_TELEMETRY_GAUGE_H
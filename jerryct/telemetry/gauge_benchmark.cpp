@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/gauge.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+void GaugeSet(benchmark::State &state) {
+  jerryct::telemetry::Gauge g{jerryct::telemetry::Meter(), std::string(64, 's')};
+  std::int64_t v{0};
+  for (auto _ : state) {
+    g.Set(v++);
+    benchmark::ClobberMemory();
+  }
+}
+
+void GaugeAdd(benchmark::State &state) {
+  jerryct::telemetry::Gauge g{jerryct::telemetry::Meter(), std::string(64, 'a')};
+  for (auto _ : state) {
+    g.Increment();
+    benchmark::ClobberMemory();
+  }
+}
+
+BENCHMARK(GaugeSet)->Threads(1)->Threads(4);
+BENCHMARK(GaugeAdd);
+
+} // namespace
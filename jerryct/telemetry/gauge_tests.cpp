@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/gauge.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace jerryct {
+namespace telemetry {
+namespace {
+
+std::int64_t Export(MeterImpl &meter, const string_view name) {
+  std::int64_t value{};
+  meter.ExportGauges([&value, name](const Measurements<std::int64_t> &data) { value = data.at(name); });
+  return value;
+}
+
+TEST(GaugeTest, WhenIncrementedAndDecremented_ExpectSignedSum) {
+  MeterImpl meter{};
+
+  std::thread t{[&meter]() {
+    Gauge g{meter, "in_flight"};
+
+    std::thread t1{[g]() mutable {
+      for (int i{0}; i < 1000; ++i) {
+        g.Increment();
+      }
+    }};
+    std::thread t2{[g]() mutable {
+      for (int i{0}; i < 1500; ++i) {
+        g.Decrement();
+      }
+    }};
+    t1.join();
+    t2.join();
+  }};
+  t.join();
+
+  EXPECT_EQ(-500, Export(meter, "in_flight"));
+}
+
+TEST(GaugeTest, WhenSetFromMultipleThreads_ExpectLastValueWins) {
+  MeterImpl meter{};
+  Gauge g{meter, "pool_size"};
+
+  std::thread t1{[g]() mutable { g.Set(3); }};
+  t1.join();
+  std::thread t2{[g]() mutable { g.Set(7); }};
+  t2.join();
+
+  EXPECT_EQ(7, Export(meter, "pool_size"));
+
+  std::thread t3{[g]() mutable { g.Set(5); }};
+  t3.join();
+
+  EXPECT_EQ(5, Export(meter, "pool_size"));
+}
+
+TEST(GaugeTest, WhenAddedAfterSet_ExpectAddsOnTopOfSet) {
+  MeterImpl meter{};
+  Gauge g{meter, "queue_depth"};
+
+  std::thread t1{[g]() mutable {
+    g.Add(100);
+    g.Set(10);
+    g.Add(2);
+  }};
+  t1.join();
+
+  EXPECT_EQ(12, Export(meter, "queue_depth"));
+
+  std::thread t2{[g]() mutable { g.Add(-4); }};
+  t2.join();
+
+  EXPECT_EQ(8, Export(meter, "queue_depth"));
+}
+
+TEST(GaugeTest, WhenAddedByOtherThreadAfterSet_ExpectAddsOnTopOfSet) {
+  MeterImpl meter{};
+  Gauge g{meter, "queue_depth"};
+
+  std::thread t1{[g]() mutable { g.Add(100); }};
+  t1.join();
+  std::thread t2{[g]() mutable { g.Set(10); }};
+  t2.join();
+  std::thread t3{[g]() mutable { g.Add(5); }};
+  t3.join();
+
+  EXPECT_EQ(15, Export(meter, "queue_depth"));
+}
+
+TEST(GaugeTest, WhenThreadAddsBeforeAndAfterSetOfOtherThread_ExpectOnlyLaterAddsCount) {
+  MeterImpl meter{};
+  Gauge g{meter, "queue_depth"};
+  std::atomic<int> step{0};
+
+  std::thread adder{[g, &step]() mutable {
+    g.Add(100);
+    step = 1;
+    while (step != 2) {
+      std::this_thread::yield();
+    }
+    g.Add(3);
+  }};
+  while (step != 1) {
+    std::this_thread::yield();
+  }
+  g.Set(10);
+  step = 2;
+  adder.join();
+
+  EXPECT_EQ(13, Export(meter, "queue_depth"));
+}
+
+} // namespace
+} // namespace telemetry
+} // namespace jerryct
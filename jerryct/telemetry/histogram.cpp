@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/histogram.h"
+
+namespace jerryct {
+namespace telemetry {
+
+constexpr std::uint32_t LogLinearBuckets::count;
+
+Histogram::Histogram(MeterImpl &t, const jerryct::string_view name)
+    : t_{&t}, slot_{t_->RegisterHistogram(name) * histogram_slots} {}
+
+void Histogram::Record(const std::uint64_t v) {
+  HistogramSlots *const s{t_->PerThreadHistograms()};
+  s->Add(slot_ + LogLinearBuckets::Index(v), 1U);
+  s->Add(slot_ + histogram_sum_slot, v);
+}
+
+ScopedTimer::~ScopedTimer() noexcept {
+  const auto d = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+  h_->Record(static_cast<std::uint64_t>(d.count()));
+}
+
+} // namespace telemetry
+} // namespace jerryct
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: MIT
+
+#ifndef JERRYCT_TELEMETRY_HISTOGRAM_H
+#define JERRYCT_TELEMETRY_HISTOGRAM_H
+
+#include "jerryct/string_view.h"
+#include "jerryct/telemetry/meter.h"
+#include <chrono>
+#include <cstdint>
+
+namespace jerryct {
+namespace telemetry {
+
+// Distribution of values like latencies or sizes in LogLinearBuckets. Recording neither locks nor allocates, except
+// for the chunk of a histogram allocated on its first use in a thread.
+class Histogram final {
+public:
+  Histogram(MeterImpl &t, const jerryct::string_view name);
+
+  void Record(const std::uint64_t v);
+
+private:
+  MeterImpl *t_;
+  std::uint32_t slot_;
+};
+
+// Records its lifetime in nanoseconds into a histogram without going through the tracer.
+class ScopedTimer final {
+public:
+  explicit ScopedTimer(Histogram &h) : h_{&h}, start_{std::chrono::steady_clock::now()} {}
+  ScopedTimer(const ScopedTimer &) = delete;
+  ScopedTimer(ScopedTimer &&) = delete;
+  ScopedTimer &operator=(const ScopedTimer &) = delete;
+  ScopedTimer &operator=(ScopedTimer &&) = delete;
+  ~ScopedTimer() noexcept;
+
+private:
+  Histogram *h_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace telemetry
+} // namespace jerryct
+
+#endif // JERRYCT_TELEMETRY_HISTOGRAM_H
@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/histogram.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+void Histogram(benchmark::State &state) {
+  jerryct::telemetry::Histogram h{jerryct::telemetry::Meter(), std::string(64, 'h')};
+  std::uint64_t v{0U};
+  for (auto _ : state) {
+    h.Record(v++);
+    benchmark::ClobberMemory();
+  }
+}
+
+void ScopedTimer(benchmark::State &state) {
+  jerryct::telemetry::Histogram h{jerryct::telemetry::Meter(), std::string(64, 't')};
+  for (auto _ : state) {
+    jerryct::telemetry::ScopedTimer timer{h};
+    benchmark::ClobberMemory();
+  }
+}
+
+BENCHMARK(Histogram);
+BENCHMARK(ScopedTimer);
+
+} // namespace
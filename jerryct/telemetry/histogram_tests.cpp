@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/histogram.h"
+#include <gtest/gtest.h>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace jerryct {
+namespace telemetry {
+namespace {
+
+TEST(LogLinearBucketsTest, WhenValueRecorded_ExpectItFallsIntoBucketBounds) {
+  const std::vector<std::uint64_t> values{0U, 1U, 3U, 4U, 7U, 8U, 9U, 1000U, 123456789U, std::uint64_t{1U} << 40U,
+                                         std::numeric_limits<std::uint64_t>::max()};
+  for (const std::uint64_t v : values) {
+    const std::uint32_t i{LogLinearBuckets::Index(v)};
+    ASSERT_LT(i, LogLinearBuckets::count);
+    EXPECT_LE(v, LogLinearBuckets::UpperBound(i));
+    if (i > 0U) {
+      EXPECT_GT(v, LogLinearBuckets::UpperBound(i - 1U));
+    }
+  }
+  EXPECT_EQ(std::numeric_limits<std::uint64_t>::max(), LogLinearBuckets::UpperBound(LogLinearBuckets::count - 1U));
+}
+
+TEST(HistogramTest, WhenRecordedFromMultipleThreads_ExpectMergedBuckets) {
+  MeterImpl meter{};
+
+  std::thread t{[&meter]() {
+    Histogram h{meter, "latency"};
+
+    std::thread t1{[h]() mutable {
+      for (int i{0}; i < 1000; ++i) {
+        h.Record(5U);
+      }
+    }};
+    std::thread t2{[h]() mutable {
+      for (int i{0}; i < 500; ++i) {
+        h.Record(1000U);
+      }
+    }};
+    t1.join();
+    t2.join();
+  }};
+  t.join();
+
+  meter.ExportHistograms([](const Measurements<HistogramSnapshot> &data) {
+    ASSERT_EQ(1U, data.size());
+    const HistogramSnapshot &h{data.at("latency")};
+    EXPECT_EQ(1500U, h.count);
+    EXPECT_EQ(5000U + 500000U, h.sum);
+    EXPECT_EQ(1000U, h.buckets[LogLinearBuckets::Index(5U)]);
+    EXPECT_EQ(500U, h.buckets[LogLinearBuckets::Index(1000U)]);
+  });
+}
+
+TEST(HistogramTest, WhenScopedTimerEnds_ExpectOneDurationRecorded) {
+  MeterImpl meter{};
+
+  std::thread t{[&meter]() {
+    Histogram h{meter, "duration"};
+    ScopedTimer timer{h};
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }};
+  t.join();
+
+  meter.ExportHistograms([](const Measurements<HistogramSnapshot> &data) {
+    const HistogramSnapshot &h{data.at("duration")};
+    EXPECT_EQ(1U, h.count);
+    EXPECT_LE(1000000U, h.sum);
+  });
+}
+
+} // namespace
+} // namespace telemetry
+} // namespace jerryct
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/json_format.h"
+#include <cstddef>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace jerryct {
+namespace telemetry {
+
+namespace {
+
+// "000" to "999", so that a time stamp takes one table lookup per three digits instead of a division per digit.
+struct ThreeDigits {
+  constexpr ThreeDigits() : digits{} {
+    for (std::uint32_t i{0U}; i < 1000U; ++i) {
+      digits[i][0] = static_cast<char>('0' + (i / 100U));
+      digits[i][1] = static_cast<char>('0' + ((i / 10U) % 10U));
+      digits[i][2] = static_cast<char>('0' + (i % 10U));
+    }
+  }
+
+  char digits[1000][3];
+};
+
+constexpr ThreeDigits three_digits{};
+
+bool NeedsEscape(const char c) noexcept { return (c == '"') || (c == '\\') || (static_cast<unsigned char>(c) < 0x20U); }
+
+void AppendEscape(const char c, fmt::memory_buffer &buf) {
+  if ((c == '"') || (c == '\\')) {
+    const char escaped[2]{'\\', c};
+    buf.append(escaped, escaped + 2);
+  } else {
+    constexpr char hex[]{"0123456789abcdef"};
+    const auto u = static_cast<unsigned char>(c);
+    const char escaped[6]{'\\', 'u', '0', '0', hex[u >> 4U], hex[u & 0xFU]};
+    buf.append(escaped, escaped + 6);
+  }
+}
+
+} // namespace
+
+void AppendJsonEscaped(const string_view s, fmt::memory_buffer &buf) {
+  const char *p{s.data()};
+  const char *const end{p + s.size()};
+  // Start of the characters not yet appended.
+  const char *run{p};
+
+#if defined(__SSE2__)
+  const __m128i quote{_mm_set1_epi8('"')};
+  const __m128i backslash{_mm_set1_epi8('\\')};
+  const __m128i control{_mm_set1_epi8(0x1F)};
+  while ((end - p) >= 16) {
+    const __m128i v{_mm_loadu_si128(reinterpret_cast<const __m128i *>(p))};
+    // min(v, 0x1F) == v is an unsigned v <= 0x1F, hence bytes of UTF-8 sequences are not flagged.
+    const __m128i special{_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                                       _mm_cmpeq_epi8(_mm_min_epu8(v, control), v))};
+    const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(special));
+    if (mask == 0U) {
+      p += 16;
+      continue;
+    }
+    p += __builtin_ctz(mask);
+    buf.append(run, p);
+    AppendEscape(*p, buf);
+    ++p;
+    run = p;
+  }
+#endif
+
+  for (; p != end; ++p) {
+    if (NeedsEscape(*p)) {
+      buf.append(run, p);
+      AppendEscape(*p, buf);
+      run = p + 1;
+    }
+  }
+  buf.append(run, end);
+}
+
+void AppendMicros(const std::chrono::nanoseconds d, fmt::memory_buffer &buf) {
+  const std::int64_t ns{d.count()};
+  std::uint64_t v{ns < 0 ? 0U - static_cast<std::uint64_t>(ns) : static_cast<std::uint64_t>(ns)};
+
+  // Filled from the back: three decimals, the point and the integral part in groups of three digits.
+  char out[32];
+  char *p{out + sizeof(out) - 3};
+  std::memcpy(p, three_digits.digits[v % 1000U], 3U);
+  v /= 1000U;
+  *--p = '.';
+  while (v >= 1000U) {
+    p -= 3;
+    std::memcpy(p, three_digits.digits[v % 1000U], 3U);
+    v /= 1000U;
+  }
+  const std::size_t n{v >= 100U ? 3U : (v >= 10U ? 2U : 1U)};
+  p -= n;
+  std::memcpy(p, three_digits.digits[v] + (3U - n), n);
+  if (ns < 0) {
+    *--p = '-';
+  }
+
+  buf.append(p, out + sizeof(out));
+}
+
+} // namespace telemetry
+} // namespace jerryct
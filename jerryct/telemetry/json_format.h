@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: MIT
+
+#ifndef JERRYCT_TELEMETRY_JSON_FORMAT_H
+#define JERRYCT_TELEMETRY_JSON_FORMAT_H
+
+#include "jerryct/string_view.h"
+#include <chrono>
+#include <cstdint>
+#include <fmt/format.h>
+
+namespace jerryct {
+namespace telemetry {
+
+// Appends s as the content of a JSON string, i.e. escapes '"', '\' and control characters. Runs of characters that
+// need no escaping are found 16 bytes at a time with SSE2 and appended in one go.
+void AppendJsonEscaped(const string_view s, fmt::memory_buffer &buf);
+
+// Appends d as microseconds with exactly three decimals, e.g. 1234.567 for 1234567 ns.
+void AppendMicros(const std::chrono::nanoseconds d, fmt::memory_buffer &buf);
+
+} // namespace telemetry
+} // namespace jerryct
+
+#endif // JERRYCT_TELEMETRY_JSON_FORMAT_H
@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/chrome_trace_event_exporter.h"
+#include "jerryct/telemetry/json_format.h"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+// The formatting ChromeTraceEventExporter used before AppendMicros.
+void LegacyMicros(const std::chrono::nanoseconds d, fmt::memory_buffer &buf) {
+  const auto micro = std::chrono::duration_cast<std::chrono::microseconds>(d);
+  buf.append(fmt::format_int{micro.count()});
+  buf.push_back('.');
+  const auto nano = (d - micro).count();
+  if (nano < 100) {
+    buf.push_back('0');
+  }
+  if (nano < 10) {
+    buf.push_back('0');
+  }
+  buf.append(fmt::format_int{nano});
+}
+
+// Escaping one character at a time, as ChromeTraceEventExporter did for arguments.
+void LegacyEscaped(const jerryct::string_view s, fmt::memory_buffer &buf) {
+  for (const char c : s) {
+    if ((c == '"') || (c == '\\')) {
+      buf.push_back('\\');
+      buf.push_back(c);
+    } else if (static_cast<unsigned char>(c) < 0x20U) {
+      fmt::format_to(std::back_inserter(buf), "\\u{:04x}", static_cast<unsigned>(c));
+    } else {
+      buf.push_back(c);
+    }
+  }
+}
+
+// A whole export of begin, end and complete events as ChromeTraceEventExporter formatted it before
+// AppendJsonEscaped and AppendMicros, names copied verbatim and the tid formatted per event.
+void LegacyExport(const std::int32_t tid, const std::uint64_t losts,
+                  const jerryct::telemetry::Segments<jerryct::telemetry::Event> &events,
+                  const jerryct::telemetry::NameTable &names, const jerryct::telemetry::TimeBase &time_base,
+                  fmt::memory_buffer &buf, jerryct::telemetry::FileRotate &f) {
+  for (const jerryct::telemetry::Event &e : events) {
+    switch (e.phase) {
+    case jerryct::telemetry::Phase::begin:
+      buf.append(fmt::string_view{R"({"name":")"});
+      buf.append(names.Get(e.name));
+      buf.append(fmt::string_view{R"(","pid":0,"tid":)"});
+      buf.append(fmt::format_int{tid});
+      buf.append(fmt::string_view{R"(,"ph":"B","ts":)"});
+      LegacyMicros(time_base.ToTimePoint(e.time_stamp).time_since_epoch(), buf);
+      buf.append(fmt::string_view{R"(},)"});
+      break;
+    case jerryct::telemetry::Phase::end:
+      buf.append(fmt::string_view{R"({"pid":0,"tid":)"});
+      buf.append(fmt::format_int{tid});
+      buf.append(fmt::string_view{R"(,"ph":"E","ts":)"});
+      LegacyMicros(time_base.ToTimePoint(e.time_stamp).time_since_epoch(), buf);
+      buf.append(fmt::string_view{R"(},)"});
+      break;
+    case jerryct::telemetry::Phase::complete:
+      buf.append(fmt::string_view{R"({"name":")"});
+      buf.append(names.Get(e.name));
+      buf.append(fmt::string_view{R"(","pid":0,"tid":)"});
+      buf.append(fmt::format_int{tid});
+      buf.append(fmt::string_view{R"(,"ph":"X","ts":)"});
+      LegacyMicros(time_base.ToTimePoint(e.time_stamp).time_since_epoch(), buf);
+      buf.append(fmt::string_view{R"(,"dur":)"});
+      LegacyMicros(time_base.ToDuration(e.duration), buf);
+      buf.append(fmt::string_view{R"(},)"});
+      break;
+    default:
+      break;
+    }
+  }
+
+  if (!events.empty()) {
+    buf.append(fmt::string_view{R"({"pid":0,"name":"total lost events","ph":"C","ts":)"});
+    LegacyMicros(time_base.ToTimePoint(events.back().time_stamp).time_since_epoch(), buf);
+    buf.append(fmt::string_view{R"(,"args":{"value":)"});
+    buf.append(fmt::format_int{losts});
+    buf.append(fmt::string_view{R"(}},)"});
+  }
+
+  f.Write(buf.data(), buf.size());
+  buf.clear();
+}
+
+std::vector<jerryct::telemetry::Event> ExportedEvents(const std::uint32_t name) {
+  std::vector<jerryct::telemetry::Event> events{};
+  for (std::int64_t i{0}; i < 1024; i += 2) {
+    events.push_back(jerryct::telemetry::Event{jerryct::telemetry::Phase::begin, name & 0xFFFFFFU, 0U, 1000 * i});
+    events.push_back(jerryct::telemetry::Event{jerryct::telemetry::Phase::end, 0U, 0U, 1000 * i + 500});
+  }
+  return events;
+}
+
+void FormatMicros_Legacy(benchmark::State &state) {
+  fmt::memory_buffer buf{};
+  std::int64_t ns{1234567890123};
+  for (auto _ : state) {
+    LegacyMicros(std::chrono::nanoseconds{ns++}, buf);
+    buf.clear();
+  }
+}
+
+void FormatMicros(benchmark::State &state) {
+  fmt::memory_buffer buf{};
+  std::int64_t ns{1234567890123};
+  for (auto _ : state) {
+    jerryct::telemetry::AppendMicros(std::chrono::nanoseconds{ns++}, buf);
+    buf.clear();
+  }
+}
+
+void EscapeName_Legacy(benchmark::State &state) {
+  fmt::memory_buffer buf{};
+  const std::string name(64, 'c');
+  for (auto _ : state) {
+    LegacyEscaped(name, buf);
+    buf.clear();
+  }
+}
+
+void EscapeName(benchmark::State &state) {
+  fmt::memory_buffer buf{};
+  const std::string name(64, 'c');
+  for (auto _ : state) {
+    jerryct::telemetry::AppendJsonEscaped(name, buf);
+    buf.clear();
+  }
+}
+
+// Events per second of a whole export as formatted before, the baseline of ExportChromeTraceEvents.
+void ExportChromeTraceEvents_Legacy(benchmark::State &state) {
+  jerryct::telemetry::NameTable names{};
+  names.Register("");
+  const std::vector<jerryct::telemetry::Event> events{ExportedEvents(names.Register(std::string(64, 'c')))};
+  const jerryct::telemetry::Segments<jerryct::telemetry::Event> segments{
+      jerryct::telemetry::Segment<jerryct::telemetry::Event>{events.data(), events.data() + events.size()}};
+  jerryct::telemetry::FileRotate f{"test_legacy.json"};
+  fmt::memory_buffer buf{};
+
+  for (auto _ : state) {
+    LegacyExport(0, 0U, segments, names, jerryct::telemetry::TimeBase{}, buf, f);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(events.size()));
+}
+
+// Events per second of a whole export.
+void ExportChromeTraceEvents(benchmark::State &state) {
+  jerryct::telemetry::NameTable names{};
+  names.Register("");
+  const std::vector<jerryct::telemetry::Event> events{ExportedEvents(names.Register(std::string(64, 'c')))};
+  const jerryct::telemetry::Segments<jerryct::telemetry::Event> segments{
+      jerryct::telemetry::Segment<jerryct::telemetry::Event>{events.data(), events.data() + events.size()}};
+  jerryct::telemetry::ChromeTraceEventExporter chrome{"test.json"};
+
+  for (auto _ : state) {
+    chrome(0, 0U, segments, names, jerryct::telemetry::TimeBase{});
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(events.size()));
+}
+
+BENCHMARK(FormatMicros_Legacy);
+BENCHMARK(FormatMicros);
+BENCHMARK(EscapeName_Legacy);
+BENCHMARK(EscapeName);
+BENCHMARK(ExportChromeTraceEvents_Legacy);
+BENCHMARK(ExportChromeTraceEvents);
+
+} // namespace
@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/json_format.h"
+#include <gtest/gtest.h>
+#include <string>
+
+namespace jerryct {
+namespace telemetry {
+namespace {
+
+std::string Escaped(const std::string &s) {
+  fmt::memory_buffer buf{};
+  AppendJsonEscaped(string_view{s.data(), s.size()}, buf);
+  return fmt::to_string(buf);
+}
+
+std::string Micros(const std::int64_t ns) {
+  fmt::memory_buffer buf{};
+  AppendMicros(std::chrono::nanoseconds{ns}, buf);
+  return fmt::to_string(buf);
+}
+
+TEST(JsonFormatTest, Escaping) {
+  EXPECT_EQ("", Escaped(""));
+  EXPECT_EQ("abc", Escaped("abc"));
+  EXPECT_EQ(R"(a\"b\\c)", Escaped(R"(a"b\c)"));
+  EXPECT_EQ(R"(\u000a\u001f )", Escaped("\n\x1F "));
+}
+
+TEST(JsonFormatTest, Escaping_WhenLongerThanOneBlock) {
+  const std::string plain(40U, 'x');
+  for (std::size_t i{0U}; i < plain.size(); ++i) {
+    std::string s{plain};
+    s[i] = '"';
+    std::string expected{plain.substr(0U, i) + R"(\")" + plain.substr(i + 1U)};
+
+    EXPECT_EQ(expected, Escaped(s));
+  }
+  EXPECT_EQ(plain, Escaped(plain));
+  EXPECT_EQ(R"(\\)" + plain + R"(\\)", Escaped(R"(\)" + plain + R"(\)"));
+}
+
+TEST(JsonFormatTest, Escaping_WhenUtf8_ExpectUnchanged) {
+  const std::string s{"\xC3\xA4\xC3\xB6\xC3\xBC\xE2\x82\xAC\xF0\x9F\x98\x80 and some more ascii"};
+
+  EXPECT_EQ(s, Escaped(s));
+}
+
+TEST(JsonFormatTest, Micros) {
+  EXPECT_EQ("0.000", Micros(0));
+  EXPECT_EQ("0.001", Micros(1));
+  EXPECT_EQ("0.999", Micros(999));
+  EXPECT_EQ("1.000", Micros(1000));
+  EXPECT_EQ("12.034", Micros(12034));
+  EXPECT_EQ("1000.000", Micros(1000000));
+  EXPECT_EQ("1234567.890", Micros(1234567890));
+  EXPECT_EQ("9223372036854775.807", Micros(9223372036854775807));
+  EXPECT_EQ("-1.500", Micros(-1500));
+}
+
+} // namespace
+} // namespace telemetry
+} // namespace jerryct
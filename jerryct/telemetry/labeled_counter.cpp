@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/labeled_counter.h"
+
+namespace jerryct {
+namespace telemetry {
+
+LabeledCounter::LabeledCounter(MeterImpl &t, const std::uint32_t series) : t_{&t}, series_{series} {}
+
+void LabeledCounter::Add() { t_->PerThreadSeries()->Add(series_, 1U); }
+void LabeledCounter::Add(const std::int64_t v) { t_->PerThreadSeries()->Add(series_, static_cast<std::uint64_t>(v)); }
+
+CounterFamily::CounterFamily(MeterImpl &t, const jerryct::string_view name, const std::uint32_t cardinality)
+    : t_{&t}, family_{t_->RegisterCounterFamily(name, cardinality)} {}
+
+LabeledCounter CounterFamily::WithLabels(const std::initializer_list<Label> labels) const {
+  return LabeledCounter{*t_, t_->RegisterSeries(family_, labels)};
+}
+
+} // namespace telemetry
+} // namespace jerryct
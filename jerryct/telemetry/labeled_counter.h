@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: MIT
+
+#ifndef JERRYCT_TELEMETRY_LABELED_COUNTER_H
+#define JERRYCT_TELEMETRY_LABELED_COUNTER_H
+
+#include "jerryct/string_view.h"
+#include "jerryct/telemetry/meter.h"
+#include "jerryct/telemetry/series_table.h"
+#include <cstdint>
+#include <initializer_list>
+
+namespace jerryct {
+namespace telemetry {
+
+// Counter of one label set of a CounterFamily. Adding is a single add to the slot of its series id.
+class LabeledCounter final {
+public:
+  LabeledCounter(MeterImpl &t, const std::uint32_t series);
+
+  void Add();
+  void Add(const std::int64_t v);
+
+private:
+  MeterImpl *t_;
+  std::uint32_t series_;
+};
+
+// Counters sharing a name which are told apart by label sets like {{"endpoint", "/"}, {"status", "200"}}. Label sets
+// are interned once per WithLabels() call; label sets beyond cardinality are counted in one overflow series.
+class CounterFamily final {
+public:
+  CounterFamily(MeterImpl &t, const jerryct::string_view name, const std::uint32_t cardinality = 1000U);
+
+  LabeledCounter WithLabels(const std::initializer_list<Label> labels) const;
+
+private:
+  MeterImpl *t_;
+  std::uint32_t family_;
+};
+
+} // namespace telemetry
+} // namespace jerryct
+
+#endif // JERRYCT_TELEMETRY_LABELED_COUNTER_H
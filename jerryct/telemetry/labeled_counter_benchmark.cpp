@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/labeled_counter.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+void LabeledCounter(benchmark::State &state) {
+  const jerryct::telemetry::CounterFamily requests{jerryct::telemetry::Meter(), "requests"};
+  jerryct::telemetry::LabeledCounter c{requests.WithLabels({{"endpoint", "/"}, {"status", "200"}})};
+  for (auto _ : state) {
+    c.Add();
+    benchmark::ClobberMemory();
+  }
+}
+
+void CounterFamilyWithLabels(benchmark::State &state) {
+  const jerryct::telemetry::CounterFamily requests{jerryct::telemetry::Meter(), "requests"};
+  for (auto _ : state) {
+    requests.WithLabels({{"endpoint", "/"}, {"status", "200"}}).Add();
+    benchmark::ClobberMemory();
+  }
+}
+
+BENCHMARK(LabeledCounter);
+BENCHMARK(CounterFamilyWithLabels);
+
+} // namespace
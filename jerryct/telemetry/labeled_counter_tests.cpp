@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/labeled_counter.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace jerryct {
+namespace telemetry {
+namespace {
+
+std::vector<std::string> Export(MeterImpl &meter) {
+  std::vector<std::string> series{};
+  meter.ExportLabeledCounters([&series](const Measurements<LabeledValue> &data) {
+    for (const Measurement<LabeledValue> &l : data) {
+      series.push_back(std::string{l.name.data(), l.name.size()} + "{" +
+                       std::string{l.value.labels.data(), l.value.labels.size()} + "} " +
+                       std::to_string(l.value.value));
+    }
+  });
+  return series;
+}
+
+TEST(LabeledCounterTest, WhenCountingPerLabelSet_ExpectSortedSeries) {
+  MeterImpl meter{};
+
+  std::thread t{[&meter]() {
+    const CounterFamily requests{meter, "requests"};
+    LabeledCounter ok{requests.WithLabels({{"endpoint", "/"}, {"status", "200"}})};
+    LabeledCounter not_found{requests.WithLabels({{"endpoint", "/x"}, {"status", "404"}})};
+    LabeledCounter ok_again{requests.WithLabels({{"endpoint", "/"}, {"status", "200"}})};
+
+    ok.Add();
+    ok_again.Add(2);
+    not_found.Add();
+
+    const CounterFamily bytes{meter, "bytes"};
+    bytes.WithLabels({{"dir", "in"}}).Add(42);
+  }};
+  t.join();
+
+  const std::vector<std::string> expected{R"(bytes{dir="in"} 42)", R"(requests{endpoint="/",status="200"} 3)",
+                                          R"(requests{endpoint="/x",status="404"} 1)"};
+  EXPECT_EQ(expected, Export(meter));
+}
+
+TEST(LabeledCounterTest, WhenLabelValueNeedsEscaping_ExpectEscapedLabels) {
+  MeterImpl meter{};
+
+  std::thread t{[&meter]() {
+    const CounterFamily errors{meter, "errors"};
+    errors.WithLabels({{"message", "a \"b\"\\\n"}}).Add();
+  }};
+  t.join();
+
+  EXPECT_EQ(std::vector<std::string>{R"(errors{message="a \"b\"\\\n"} 1)"}, Export(meter));
+}
+
+TEST(LabeledCounterTest, WhenCardinalityExceeded_ExpectOverflowSeries) {
+  MeterImpl meter{};
+
+  std::thread t{[&meter]() {
+    const CounterFamily requests{meter, "requests", 2U};
+    for (const char *user : {"a", "b", "c", "d"}) {
+      requests.WithLabels({{"user", user}}).Add();
+    }
+  }};
+  t.join();
+
+  const std::vector<std::string> expected{R"(requests{overflow="true"} 2)", R"(requests{user="a"} 1)",
+                                          R"(requests{user="b"} 1)"};
+  EXPECT_EQ(expected, Export(meter));
+}
+
+} // namespace
+} // namespace telemetry
+} // namespace jerryct
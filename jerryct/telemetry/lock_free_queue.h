@@ -3,62 +3,348 @@
 #ifndef JERRYCT_TELEMETRY_LOCK_FREE_QUEUE_H
 #define JERRYCT_TELEMETRY_LOCK_FREE_QUEUE_H
 
+#include <algorithm>
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <sys/mman.h>
 #include <type_traits>
 #include <utility>
 
 namespace jerryct {
 namespace telemetry {
 
-template <typename T, std::uint32_t S> class LockFreeQueue {
+// What Emplace() does when the queue is full. Every element which does not make it to the consumer counts as lost.
+//
+// drop_newest discards the element to be emplaced.
+// overwrite_oldest discards the oldest element instead. While a consumer is running it falls back to drop_newest, so
+// elements handed to the consumer are never overwritten.
+// spill moves new elements into an overflow ring of at most spill_budget bytes and max_capacity elements, which is
+// allocated on first use. Elements which find no room count as lost, also if allocating the ring failed. Once spilled,
+// elements keep going to the overflow ring until the consumer emptied it so the order is preserved.
+enum class Overflow : std::int32_t { drop_newest, overwrite_oldest, spill };
+
+// Contiguous, read-only elements of a LockFreeQueue.
+template <typename T> class Segment {
+public:
+  Segment() noexcept = default;
+  Segment(const T *const first, const T *const last) noexcept : first_{first}, last_{last} {}
+
+  const T *begin() const noexcept { return first_; }
+  const T *end() const noexcept { return last_; }
+  std::size_t size() const noexcept { return static_cast<std::size_t>(last_ - first_); }
+  bool empty() const noexcept { return first_ == last_; }
+
+private:
+  const T *first_{nullptr};
+  const T *last_{nullptr};
+};
+
+// The readable elements of a LockFreeQueue in order: up to two segments of the ring followed by up to two segments of
+// the spill ring. Iterating visits the elements of all segments.
+template <typename T> class Segments {
+public:
+  class Iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T *;
+    using reference = const T &;
+
+    Iterator(const Segment<T> *const segment, const Segment<T> *const last) noexcept
+        : segment_{segment}, last_{last}, element_{segment == last ? nullptr : segment->begin()} {}
+
+    const T &operator*() const noexcept { return *element_; }
+    const T *operator->() const noexcept { return element_; }
+    Iterator &operator++() noexcept {
+      ++element_;
+      if (element_ == segment_->end()) {
+        ++segment_;
+        element_ = segment_ == last_ ? nullptr : segment_->begin();
+      }
+      return *this;
+    }
+    Iterator operator++(int) noexcept {
+      Iterator it{*this};
+      ++*this;
+      return it;
+    }
+    bool operator==(const Iterator &other) const noexcept {
+      return (segment_ == other.segment_) && (element_ == other.element_);
+    }
+    bool operator!=(const Iterator &other) const noexcept { return !(*this == other); }
+
+  private:
+    const Segment<T> *segment_;
+    const Segment<T> *last_;
+    const T *element_;
+  };
+
+  Segments() noexcept = default;
+  explicit Segments(const Segment<T> segment) noexcept { Append(segment); }
+
+  // Empty segments are skipped, so every segment holds at least one element.
+  void Append(const Segment<T> segment) noexcept {
+    if (!segment.empty()) {
+      segments_[count_] = segment;
+      ++count_;
+    }
+  }
+
+  std::size_t SegmentCount() const noexcept { return count_; }
+  const Segment<T> &GetSegment(const std::size_t i) const noexcept { return segments_[i]; }
+
+  Iterator begin() const noexcept { return Iterator{&segments_[0U], &segments_[count_]}; }
+  Iterator end() const noexcept { return Iterator{&segments_[count_], &segments_[count_]}; }
+  bool empty() const noexcept { return count_ == 0U; }
+  std::size_t size() const noexcept {
+    std::size_t n{0U};
+    for (std::size_t i{0U}; i < count_; ++i) {
+      n += segments_[i].size();
+    }
+    return n;
+  }
+  const T &back() const noexcept { return *(segments_[count_ - 1U].end() - 1); }
+
+private:
+  Segment<T> segments_[4U];
+  std::size_t count_{0U};
+};
+
+// Single-producer single-consumer ring which holds up to capacity - 1 elements; capacity is rounded up to a power of
+// two and must not exceed max_capacity. The slots are reserved as virtual memory only, so the pages are committed by
+// the kernel when the producer first writes to them and a thread which emits little never pays for the full capacity.
+template <typename T> class LockFreeQueue {
   static_assert(std::is_trivially_destructible<T>::value, "");
 
-  struct ManualLifetime {
-    ManualLifetime() noexcept {}
-    ~ManualLifetime() noexcept {}
-    union {
-      T value_;
-    };
+  struct SpillRing {
+    explicit SpillRing(const std::uint32_t size) : d_{Reserve(size)}, size_{size} {}
+    SpillRing(const SpillRing &) = delete;
+    SpillRing(SpillRing &&) = delete;
+    SpillRing &operator=(const SpillRing &) = delete;
+    SpillRing &operator=(SpillRing &&) = delete;
+    ~SpillRing() noexcept { Release(d_, size_); }
+
+    alignas(64) std::atomic<std::uint32_t> head_{};
+    alignas(64) std::atomic<std::uint32_t> tail_{};
+    T *const d_;
+    const std::uint32_t size_;
   };
 
 public:
+  static constexpr std::uint32_t max_capacity{0x80000000U};
+
+  // Throws std::invalid_argument if capacity exceeds max_capacity.
+  explicit LockFreeQueue(const std::uint32_t capacity = 4096U, const Overflow overflow = Overflow::drop_newest,
+                         const std::size_t spill_budget = 0U)
+      : overflow_{overflow}, spill_size_{SpillSize(spill_budget)},
+        mask_{RoundUpToPowerOfTwo(capacity) - 1U}, d_{Reserve(mask_ + 1U)} {}
+  LockFreeQueue(const LockFreeQueue &) = delete;
+  LockFreeQueue(LockFreeQueue &&) = delete;
+  LockFreeQueue &operator=(const LockFreeQueue &) = delete;
+  LockFreeQueue &operator=(LockFreeQueue &&) = delete;
+  ~LockFreeQueue() noexcept {
+    SpillRing *const s{spill_.load(std::memory_order_relaxed)};
+    if (s != nullptr) {
+      s->~SpillRing();
+      std::free(s);
+    }
+    Release(d_, mask_ + 1U);
+  }
+
   template <typename... U> void Emplace(U &&... us) {
-    const std::uint32_t ta{tail_.load(std::memory_order_acquire)};
+    if (spilling_ && !SpillDrained()) {
+      Spill(std::forward<U>(us)...);
+      return;
+    }
+    spilling_ = false;
+
+    std::uint32_t ta{tail_.load(std::memory_order_acquire)};
     const std::uint32_t he{head_.load(std::memory_order_relaxed)};
 
-    const std::uint32_t the_next{(he + 1U) % S};
+    const std::uint32_t the_next{(he + 1U) & mask_};
 
     if (the_next == ta) {
-      losts_.store(losts_.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
-      return;
+      switch (overflow_) {
+      case Overflow::drop_newest:
+        Lost();
+        return;
+      case Overflow::overwrite_oldest:
+        if (consuming_.load(std::memory_order_seq_cst)) {
+          Lost();
+          return;
+        }
+        if (tail_.compare_exchange_strong(ta, (ta + 1U) & mask_, std::memory_order_seq_cst)) {
+          Lost();
+        }
+        break;
+      case Overflow::spill:
+        Spill(std::forward<U>(us)...);
+        return;
+      }
     }
 
     new (&d_[he]) T{std::forward<U>(us)...};
     head_.store(the_next, std::memory_order_release);
   }
 
-  template <typename F> void ConsumeAll(F &&func) {
+  // Hands all readable elements in place to func(const Segments<T> &). The slots are released only after func
+  // returned, so the producer cannot reuse them while func reads.
+  template <typename F> void Drain(F &&func) {
+    if (overflow_ == Overflow::overwrite_oldest) {
+      consuming_.store(true, std::memory_order_seq_cst);
+    }
+
+    // The spill ring is read first: the producer writes to the ring again only once the spill ring was released, so
+    // every element of the ring read afterwards is older than the spilled ones.
+    SpillRing *const s{spill_.load(std::memory_order_acquire)};
+    std::uint32_t spill_he{0U};
+    if (s != nullptr) {
+      spill_he = s->head_.load(std::memory_order_acquire);
+    }
+
     const std::uint32_t he{head_.load(std::memory_order_acquire)};
-    std::uint32_t ta{tail_.load(std::memory_order_relaxed)};
+    const std::uint32_t ta{tail_.load(std::memory_order_seq_cst)};
 
-    for (; ta != he;) {
-      func(std::move(d_[ta].value_));
-      ta = (ta + 1U) % S;
+    Segments<T> segments{};
+    Collect(d_, mask_ + 1U, ta, he, segments);
+    if (s != nullptr) {
+      Collect(s->d_, s->size_, s->tail_.load(std::memory_order_relaxed), spill_he, segments);
     }
 
-    tail_.store(ta, std::memory_order_release);
+    std::forward<F>(func)(static_cast<const Segments<T> &>(segments));
+
+    tail_.store(he, std::memory_order_release);
+
+    if (overflow_ == Overflow::overwrite_oldest) {
+      consuming_.store(false, std::memory_order_release);
+    }
+
+    if (s != nullptr) {
+      s->tail_.store(spill_he, std::memory_order_release);
+    }
+  }
+
+  template <typename F> void ConsumeAll(F &&func) {
+    Drain([&func](const Segments<T> &segments) {
+      for (const T &v : segments) {
+        func(v);
+      }
+    });
   }
 
   std::uint64_t Losts() const { return losts_.load(std::memory_order_relaxed); }
 
+  std::uint32_t Capacity() const noexcept { return mask_ + 1U; }
+
 private:
+  static void Collect(const T *const d, const std::uint32_t size, const std::uint32_t ta, const std::uint32_t he,
+                      Segments<T> &segments) noexcept {
+    if (ta <= he) {
+      segments.Append(Segment<T>{d + ta, d + he});
+    } else {
+      segments.Append(Segment<T>{d + ta, d + size});
+      segments.Append(Segment<T>{d, d + he});
+    }
+  }
+
+  static std::uint32_t RoundUpToPowerOfTwo(const std::uint32_t v) {
+    if (v > max_capacity) {
+      throw std::invalid_argument{"queue capacity too large"};
+    }
+    std::uint32_t r{2U};
+    while (r < v) {
+      r *= 2U;
+    }
+    return r;
+  }
+
+  // Elements of the spill ring; larger budgets are clamped to max_capacity elements.
+  static std::uint32_t SpillSize(const std::size_t spill_budget) noexcept {
+    return static_cast<std::uint32_t>(std::min(spill_budget / sizeof(T), std::size_t{max_capacity}));
+  }
+
+  static T *Reserve(const std::uint32_t size) {
+    void *const memory{::mmap(nullptr, std::size_t{size} * sizeof(T), PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0)};
+    if (memory == MAP_FAILED) {
+      throw std::bad_alloc{};
+    }
+    return static_cast<T *>(memory);
+  }
+
+  static void Release(T *const d, const std::uint32_t size) noexcept { ::munmap(d, std::size_t{size} * sizeof(T)); }
+
+  void Lost() { losts_.store(losts_.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed); }
+
+  bool SpillDrained() const {
+    const SpillRing *const s{spill_.load(std::memory_order_relaxed)};
+    return s->tail_.load(std::memory_order_acquire) == s->head_.load(std::memory_order_relaxed);
+  }
+
+  // Returns nullptr if the spill ring is disabled or cannot be allocated. The element is lost then instead of throwing
+  // from Emplace(), which runs e.g. in the destructor of Span.
+  SpillRing *NewSpillRing() const noexcept {
+    if (spill_size_ < 2U) {
+      return nullptr;
+    }
+    void *const memory{::aligned_alloc(alignof(SpillRing), sizeof(SpillRing))};
+    if (memory == nullptr) {
+      return nullptr;
+    }
+    try {
+      return new (memory) SpillRing{spill_size_};
+    } catch (const std::bad_alloc &) {
+      std::free(memory);
+      return nullptr;
+    }
+  }
+
+  template <typename... U> void Spill(U &&... us) {
+    SpillRing *s{spill_.load(std::memory_order_relaxed)};
+    if (s == nullptr) {
+      s = NewSpillRing();
+      if (s == nullptr) {
+        Lost();
+        return;
+      }
+      spill_.store(s, std::memory_order_release);
+    }
+
+    const std::uint32_t ta{s->tail_.load(std::memory_order_acquire)};
+    const std::uint32_t he{s->head_.load(std::memory_order_relaxed)};
+
+    const std::uint32_t the_next{(he + 1U) % s->size_};
+
+    if (the_next == ta) {
+      Lost();
+      return;
+    }
+
+    new (&s->d_[he]) T{std::forward<U>(us)...};
+    s->head_.store(the_next, std::memory_order_release);
+    spilling_ = true;
+  }
+
   alignas(64) std::atomic<std::uint32_t> head_{};
+  bool spilling_{false};
   alignas(64) std::atomic<std::uint32_t> tail_{};
+  std::atomic<bool> consuming_{false};
   alignas(64) std::atomic<std::uint64_t> losts_{};
-  alignas(64) ManualLifetime d_[S];
+  const Overflow overflow_;
+  const std::uint32_t spill_size_;
+  std::atomic<SpillRing *> spill_{nullptr};
+  const std::uint32_t mask_;
+  T *const d_;
 };
 
+template <typename T> constexpr std::uint32_t LockFreeQueue<T>::max_capacity;
+
 } // namespace telemetry
 } // namespace jerryct
 
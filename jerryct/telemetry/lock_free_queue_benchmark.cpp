@@ -6,7 +6,7 @@
 namespace {
 
 void LockFreeQueue(benchmark::State &state) {
-  jerryct::telemetry::LockFreeQueue<int, 4> r{};
+  jerryct::telemetry::LockFreeQueue<int> r{4U};
   for (auto _ : state) {
     r.Emplace(1);
     r.Emplace(2);
@@ -16,8 +16,53 @@ void LockFreeQueue(benchmark::State &state) {
   }
 }
 
+void LockFreeQueueDrain(benchmark::State &state) {
+  jerryct::telemetry::LockFreeQueue<int> r{4096U};
+  for (auto _ : state) {
+    for (int i{0}; i < 4095; ++i) {
+      r.Emplace(i);
+    }
+    r.Drain([](const jerryct::telemetry::Segments<int> &s) {
+      for (std::size_t i{0U}; i < s.SegmentCount(); ++i) {
+        benchmark::DoNotOptimize(s.GetSegment(i).begin());
+      }
+    });
+    benchmark::ClobberMemory();
+  }
+}
+
 void LockFreeQueueFull(benchmark::State &state) {
-  jerryct::telemetry::LockFreeQueue<int, 1> r{};
+  jerryct::telemetry::LockFreeQueue<int> r{1U};
+  for (auto _ : state) {
+    r.Emplace(1);
+    benchmark::ClobberMemory();
+  }
+}
+
+void LockFreeQueueFullOverwriteOldest(benchmark::State &state) {
+  jerryct::telemetry::LockFreeQueue<int> r{2U, jerryct::telemetry::Overflow::overwrite_oldest};
+  for (auto _ : state) {
+    r.Emplace(1);
+    benchmark::ClobberMemory();
+  }
+}
+
+void LockFreeQueueSpill(benchmark::State &state) {
+  jerryct::telemetry::LockFreeQueue<int> r{4U, jerryct::telemetry::Overflow::spill, 64U * sizeof(int)};
+  for (auto _ : state) {
+    r.Emplace(1);
+    r.Emplace(2);
+    r.Emplace(3);
+    r.Emplace(4);
+    r.Emplace(5);
+    r.Emplace(6);
+    r.ConsumeAll([](int /*unused*/) {});
+    benchmark::ClobberMemory();
+  }
+}
+
+void LockFreeQueueFullSpill(benchmark::State &state) {
+  jerryct::telemetry::LockFreeQueue<int> r{1U, jerryct::telemetry::Overflow::spill, 64U * sizeof(int)};
   for (auto _ : state) {
     r.Emplace(1);
     benchmark::ClobberMemory();
@@ -25,6 +70,10 @@ void LockFreeQueueFull(benchmark::State &state) {
 }
 
 BENCHMARK(LockFreeQueue);
+BENCHMARK(LockFreeQueueDrain);
 BENCHMARK(LockFreeQueueFull);
+BENCHMARK(LockFreeQueueFullOverwriteOldest);
+BENCHMARK(LockFreeQueueSpill);
+BENCHMARK(LockFreeQueueFullSpill);
 
 } // namespace
@@ -1,7 +1,11 @@
 // SPDX-License-Identifier: MIT
 
 #include "jerryct/telemetry/lock_free_queue.h"
+#include <cstddef>
+#include <cstdint>
 #include <gtest/gtest.h>
+#include <limits>
+#include <stdexcept>
 #include <vector>
 
 namespace jerryct {
@@ -10,7 +14,7 @@ namespace {
 
 TEST(LockFreeQueueTest, Emplace) {
 
-  LockFreeQueue<std::int32_t, 4> r{};
+  LockFreeQueue<std::int32_t> r{4U};
 
   {
     std::vector<std::int32_t> o;
@@ -52,6 +56,143 @@ TEST(LockFreeQueueTest, Emplace) {
   }
 }
 
+TEST(LockFreeQueueTest, DrainWrappedAround_ExpectTwoSegments) {
+  LockFreeQueue<std::int32_t> r{4U};
+
+  r.Emplace(1);
+  r.Emplace(2);
+  r.ConsumeAll([](const std::int32_t /*unused*/) {});
+  r.Emplace(3);
+  r.Emplace(4);
+  r.Emplace(5);
+
+  r.Drain([](const Segments<std::int32_t> &s) {
+    ASSERT_EQ(2U, s.SegmentCount());
+    EXPECT_EQ(2U, s.GetSegment(0U).size());
+    EXPECT_EQ(1U, s.GetSegment(1U).size());
+    ASSERT_EQ(3U, s.size());
+    EXPECT_EQ(5, s.back());
+
+    const std::vector<std::int32_t> o{s.begin(), s.end()};
+    EXPECT_EQ((std::vector<std::int32_t>{3, 4, 5}), o);
+  });
+  EXPECT_EQ(0U, r.Losts());
+}
+
+TEST(LockFreeQueueTest, WhileDraining_ExpectSlotsNotReleased) {
+  LockFreeQueue<std::int32_t> r{4U};
+
+  r.Emplace(1);
+  r.Emplace(2);
+  r.Emplace(3);
+
+  r.Drain([&r](const Segments<std::int32_t> &s) {
+    r.Emplace(4);
+    EXPECT_EQ(1U, r.Losts());
+    EXPECT_EQ(3U, s.size());
+  });
+
+  r.Emplace(4);
+  std::vector<std::int32_t> o;
+  r.ConsumeAll([&o](const std::int32_t v) { o.push_back(v); });
+  EXPECT_EQ(std::vector<std::int32_t>{4}, o);
+}
+
+TEST(LockFreeQueueTest, CapacityIsRoundedUpToPowerOfTwo) {
+  LockFreeQueue<std::int32_t> r{5U};
+  ASSERT_EQ(8U, r.Capacity());
+
+  for (std::int32_t i{0}; i < 8; ++i) {
+    r.Emplace(i);
+  }
+
+  std::vector<std::int32_t> o;
+  r.ConsumeAll([&o](const std::int32_t v) { o.push_back(v); });
+  ASSERT_EQ(7U, o.size());
+  EXPECT_EQ(1U, r.Losts());
+  EXPECT_EQ(0, o.front());
+  EXPECT_EQ(6, o.back());
+}
+
+TEST(LockFreeQueueTest, WhenCapacityTooLarge_ExpectRejected) {
+  EXPECT_THROW(LockFreeQueue<std::int32_t>{0x80000001U}, std::invalid_argument);
+}
+
+TEST(LockFreeQueueTest, OverwriteOldest) {
+  LockFreeQueue<std::int32_t> r{4U, Overflow::overwrite_oldest};
+
+  r.Emplace(1);
+  r.Emplace(2);
+  r.Emplace(3);
+  r.Emplace(4);
+  r.Emplace(5);
+
+  std::vector<std::int32_t> o;
+  r.ConsumeAll([&o](const std::int32_t v) { o.push_back(v); });
+  ASSERT_EQ(3U, o.size());
+  EXPECT_EQ(2U, r.Losts());
+  EXPECT_EQ(3, o[0U]);
+  EXPECT_EQ(4, o[1U]);
+  EXPECT_EQ(5, o[2U]);
+}
+
+TEST(LockFreeQueueTest, Spill) {
+  LockFreeQueue<std::int32_t> r{4U, Overflow::spill, 3U * sizeof(std::int32_t)};
+
+  r.Emplace(1);
+  r.Emplace(2);
+  r.Emplace(3);
+  r.Emplace(4);
+  r.Emplace(5);
+  r.Emplace(6);
+
+  {
+    std::vector<std::int32_t> o;
+    r.ConsumeAll([&o](const std::int32_t v) { o.push_back(v); });
+    ASSERT_EQ(5U, o.size());
+    EXPECT_EQ(1U, r.Losts());
+    EXPECT_EQ(1, o[0U]);
+    EXPECT_EQ(2, o[1U]);
+    EXPECT_EQ(3, o[2U]);
+    EXPECT_EQ(4, o[3U]);
+    EXPECT_EQ(5, o[4U]);
+  }
+
+  r.Emplace(7);
+
+  {
+    std::vector<std::int32_t> o;
+    r.ConsumeAll([&o](const std::int32_t v) { o.push_back(v); });
+    ASSERT_EQ(1U, o.size());
+    EXPECT_EQ(1U, r.Losts());
+    EXPECT_EQ(7, o[0U]);
+  }
+}
+
+TEST(LockFreeQueueTest, Spill_WhenBudgetAboveMaxCapacity_ExpectClamped) {
+  LockFreeQueue<std::uint8_t> r{2U, Overflow::spill, (std::size_t{1U} << 32U) + 4U};
+
+  for (std::uint8_t i{0U}; i < 10U; ++i) {
+    r.Emplace(i);
+  }
+
+  EXPECT_EQ(0U, r.Losts());
+}
+
+TEST(LockFreeQueueTest, Spill_WhenAllocationFails_ExpectLost) {
+  // The clamped spill ring exceeds the address space.
+  struct Large {
+    std::uint8_t bytes[1U << 20U];
+  };
+  static const Large large{};
+  LockFreeQueue<Large> r{2U, Overflow::spill, std::numeric_limits<std::size_t>::max()};
+
+  r.Emplace(large);
+  EXPECT_NO_THROW(r.Emplace(large));
+
+  EXPECT_EQ(1U, r.Losts());
+}
+
 } // namespace
 } // namespace telemetry
 } // namespace jerryct
@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: MIT
+
+#ifndef JERRYCT_TELEMETRY_MEASUREMENTS_H
+#define JERRYCT_TELEMETRY_MEASUREMENTS_H
+
+#include "jerryct/string_view.h"
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+
+namespace jerryct {
+namespace telemetry {
+
+// Value of one metric.
+template <typename T> struct Measurement {
+  string_view name;
+  T value;
+};
+
+// Contiguous view of measurements sorted by name. Only valid during the export callback.
+template <typename T> class Measurements {
+public:
+  Measurements(const Measurement<T> *const first, const std::size_t size) : first_{first}, size_{size} {}
+
+  const Measurement<T> *begin() const { return first_; }
+  const Measurement<T> *end() const { return first_ + size_; }
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0U; }
+  const Measurement<T> &operator[](const std::size_t i) const { return first_[i]; }
+
+  // nullptr if there is no measurement of name.
+  const T *Find(const string_view name) const {
+    const Measurement<T> *const it{std::lower_bound(
+        begin(), end(), name, [](const Measurement<T> &m, const string_view n) { return m.name < n; })};
+    return ((it == end()) || (it->name != name)) ? nullptr : &it->value;
+  }
+
+  // Throws std::out_of_range if there is no measurement of name.
+  const T &at(const string_view name) const {
+    const T *const value{Find(name)};
+    if (value == nullptr) {
+      throw std::out_of_range{"no such measurement"};
+    }
+    return *value;
+  }
+
+private:
+  const Measurement<T> *first_;
+  std::size_t size_;
+};
+
+} // namespace telemetry
+} // namespace jerryct
+
+#endif // JERRYCT_TELEMETRY_MEASUREMENTS_H
@@ -4,52 +4,412 @@
 #define JERRYCT_TELEMETRY_METER_H
 
 #include "jerryct/string_view.h"
-#include "jerryct/telemetry/fixed_string.h"
-#include "jerryct/telemetry/lock_free_queue.h"
+#include "jerryct/telemetry/measurements.h"
+#include "jerryct/telemetry/name_table.h"
+#include "jerryct/telemetry/series_table.h"
 #include "jerryct/telemetry/thread_storage.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
-#include <mutex>
-#include <set>
-#include <unordered_map>
+#include <cstdlib>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <vector>
 
 namespace jerryct {
 namespace telemetry {
 
-struct Measurement {
-  std::uint64_t value;
-  const FixedString<64> *id;
+// Per-thread metric values indexed by slot. Only the owning thread writes, hence adding is a relaxed load and store
+// without any read-modify-write. Values live in cache-line-aligned chunks of ChunkSize slots which are allocated by the
+// owning thread on first use.
+template <std::uint32_t ChunkSize, std::uint32_t MaxChunks> class PerThreadSlots {
+  static constexpr std::uint32_t chunk_size_{ChunkSize};
+
+  struct alignas(64) Chunk {
+    std::atomic<std::uint64_t> values[ChunkSize];
+  };
+
+public:
+  PerThreadSlots() = default;
+  PerThreadSlots(const PerThreadSlots &) = delete;
+  PerThreadSlots(PerThreadSlots &&) = delete;
+  PerThreadSlots &operator=(const PerThreadSlots &) = delete;
+  PerThreadSlots &operator=(PerThreadSlots &&) = delete;
+  ~PerThreadSlots() noexcept {
+    for (auto &c : chunks_) {
+      Chunk *const chunk{c.load(std::memory_order_relaxed)};
+      if (chunk != nullptr) {
+        chunk->~Chunk();
+        std::free(chunk);
+      }
+    }
+  }
+
+  void Add(const std::uint32_t id, const std::uint64_t v) {
+    std::atomic<std::uint64_t> &value{At(id)};
+    value.store(value.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+  }
+
+  // Only for the owning thread. Slots of a chunk are contiguous.
+  std::atomic<std::uint64_t> &At(const std::uint32_t id) {
+    Chunk *chunk{chunks_[id / chunk_size_].load(std::memory_order_relaxed)};
+    if (chunk == nullptr) {
+      chunk = Allocate(id / chunk_size_);
+    }
+    return chunk->values[id % chunk_size_];
+  }
+
+  // nullptr if the owning thread never touched the chunk of the slot.
+  const std::atomic<std::uint64_t> *Find(const std::uint32_t id) const {
+    const Chunk *const chunk{chunks_[id / chunk_size_].load(std::memory_order_acquire)};
+    return chunk == nullptr ? nullptr : &chunk->values[id % chunk_size_];
+  }
+
+  // Adds the values of the first totals.size() slots to totals.
+  void AddTo(std::vector<std::uint64_t> &totals) const {
+    for (std::size_t i{0U}; i < totals.size(); i += chunk_size_) {
+      const Chunk *const chunk{chunks_[i / chunk_size_].load(std::memory_order_acquire)};
+      if (chunk == nullptr) {
+        continue;
+      }
+      const std::size_t n{std::min(std::size_t{chunk_size_}, totals.size() - i)};
+      for (std::size_t j{0U}; j < n; ++j) {
+        totals[i + j] += chunk->values[j].load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+private:
+  Chunk *Allocate(const std::uint32_t index) {
+    void *const memory{::aligned_alloc(alignof(Chunk), sizeof(Chunk))};
+    if (memory == nullptr) {
+      throw std::bad_alloc{};
+    }
+    Chunk *const chunk{new (memory) Chunk{}};
+    chunks_[index].store(chunk, std::memory_order_release);
+    return chunk;
+  }
+
+  std::array<std::atomic<Chunk *>, MaxChunks> chunks_{};
 };
 
-class MeterImpl {
+// Counter values indexed by the id of the registered name.
+using CounterSlots = PerThreadSlots<512U, NameTable::capacity / 512U>;
+
+// Labeled counter values indexed by series id.
+using SeriesSlots = PerThreadSlots<128U, SeriesTable::capacity / 128U>;
+
+// Log-linear buckets: values below 4 get a bucket each, every power of two above is split into 4 linear buckets. The
+// relative error is at most 25 % over the whole uint64_t range.
+struct LogLinearBuckets {
+  static constexpr std::uint32_t count{252U};
+
+  static std::uint32_t Index(const std::uint64_t v) noexcept {
+    if (v < 4U) {
+      return static_cast<std::uint32_t>(v);
+    }
+    const std::uint32_t msb{63U - static_cast<std::uint32_t>(__builtin_clzll(v))};
+    return ((msb - 1U) * 4U) + static_cast<std::uint32_t>((v >> (msb - 2U)) & 3U);
+  }
+
+  // Inclusive upper bound of the values falling into bucket i.
+  static std::uint64_t UpperBound(const std::uint32_t i) noexcept {
+    if (i < 4U) {
+      return i;
+    }
+    const std::uint32_t msb{(i / 4U) + 1U};
+    const std::uint64_t lower{std::uint64_t{4U + (i % 4U)} << (msb - 2U)};
+    return lower + ((std::uint64_t{1U} << (msb - 2U)) - 1U);
+  }
+};
+
+// Each histogram owns one chunk: its buckets followed by the sum of all recorded values.
+constexpr std::uint32_t histogram_slots{256U};
+constexpr std::uint32_t histogram_sum_slot{LogLinearBuckets::count};
+constexpr std::uint32_t max_histograms{1024U};
+using HistogramSlots = PerThreadSlots<histogram_slots, max_histograms>;
+
+// Per-thread state of gauges. Set() publishes value and time stamp through a seqlock, so the exporter reads them
+// consistently while the owning thread never waits. To order the Add()s of all threads against the newest Set() of any
+// thread, each thread also keeps the stamp of the newest Set() it knew of at its last Set() or Add(), given by
+// last_set, and the running sum of its Add()s at that time.
+class GaugeSlots {
+  static constexpr std::uint32_t seq_{0U};
+  static constexpr std::uint32_t value_{1U};
+  static constexpr std::uint32_t stamp_{2U};
+  static constexpr std::uint32_t seen_{3U};
+  static constexpr std::uint32_t delta_at_seen_{4U};
+  static constexpr std::uint32_t delta_{5U};
+  static constexpr std::uint32_t slots_per_gauge_{8U};
+
 public:
-  using Measurements = LockFreeQueue<Measurement, 4096>;
+  static constexpr std::uint32_t max_gauges{16384U};
+
+  struct Record {
+    std::int64_t stamp;
+    std::uint64_t value;
+    std::int64_t seen;
+    std::uint64_t delta_at_seen;
+    std::uint64_t delta;
+  };
 
-  MeterImpl() { RegisterName("measurement_losts"); }
+  // stamp must be positive and grow over time, 0 means never set. last_set is the stamp of the newest Set() of the
+  // gauge by any thread.
+  void Set(const std::uint32_t id, const std::int64_t v, const std::int64_t stamp,
+           std::atomic<std::int64_t> &last_set) {
+    std::atomic<std::uint64_t> *const g{&slots_.At(id * slots_per_gauge_)};
+    const std::uint64_t seq{g[seq_].load(std::memory_order_relaxed)};
+    g[seq_].store(seq + 1U, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    g[value_].store(static_cast<std::uint64_t>(v), std::memory_order_relaxed);
+    g[stamp_].store(static_cast<std::uint64_t>(stamp), std::memory_order_relaxed);
+    g[seen_].store(static_cast<std::uint64_t>(stamp), std::memory_order_relaxed);
+    g[delta_at_seen_].store(g[delta_].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    g[seq_].store(seq + 2U, std::memory_order_release);
+
+    std::int64_t newest{last_set.load(std::memory_order_relaxed)};
+    while ((newest < stamp) &&
+           !last_set.compare_exchange_weak(newest, stamp, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+  }
+
+  // Rebases the thread's sum of Add()s only once per newer Set(), otherwise just a load of last_set on top of the add.
+  void Add(const std::uint32_t id, const std::int64_t v, const std::atomic<std::int64_t> &last_set) {
+    std::atomic<std::uint64_t> *const g{&slots_.At(id * slots_per_gauge_)};
+    const std::int64_t newest{last_set.load(std::memory_order_acquire)};
+    if (newest > static_cast<std::int64_t>(g[seen_].load(std::memory_order_relaxed))) {
+      const std::uint64_t seq{g[seq_].load(std::memory_order_relaxed)};
+      g[seq_].store(seq + 1U, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      g[seen_].store(static_cast<std::uint64_t>(newest), std::memory_order_relaxed);
+      g[delta_at_seen_].store(g[delta_].load(std::memory_order_relaxed), std::memory_order_relaxed);
+      g[seq_].store(seq + 2U, std::memory_order_release);
+    }
+    g[delta_].store(g[delta_].load(std::memory_order_relaxed) + static_cast<std::uint64_t>(v),
+                    std::memory_order_relaxed);
+  }
+
+  // False if the owning thread never touched the gauge.
+  bool Read(const std::uint32_t id, Record &r) const {
+    const std::atomic<std::uint64_t> *const g{slots_.Find(id * slots_per_gauge_)};
+    if (g == nullptr) {
+      return false;
+    }
+    std::uint64_t seq{};
+    do {
+      seq = g[seq_].load(std::memory_order_acquire);
+      r.value = g[value_].load(std::memory_order_relaxed);
+      r.stamp = static_cast<std::int64_t>(g[stamp_].load(std::memory_order_relaxed));
+      r.seen = static_cast<std::int64_t>(g[seen_].load(std::memory_order_relaxed));
+      r.delta_at_seen = g[delta_at_seen_].load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+    } while (((seq % 2U) != 0U) || (seq != g[seq_].load(std::memory_order_relaxed)));
+    r.delta = g[delta_].load(std::memory_order_relaxed);
+    return true;
+  }
+
+private:
+  PerThreadSlots<512U, (max_gauges * slots_per_gauge_) / 512U> slots_;
+};
 
+// Extends order, the ids of names sorted by name, to all ids below size. Only the names registered since the last call
+// are sorted and merged in, hence exports without new names do not sort at all.
+inline void ExtendSortedOrder(const NameTable &names, const std::uint32_t size, std::vector<std::uint32_t> &order) {
+  const std::size_t sorted{order.size()};
+  if (sorted >= size) {
+    return;
+  }
+  for (std::uint32_t i{static_cast<std::uint32_t>(sorted)}; i < size; ++i) {
+    order.push_back(i);
+  }
+  const auto by_name = [&names](const std::uint32_t lhs, const std::uint32_t rhs) {
+    return names.Get(lhs) < names.Get(rhs);
+  };
+  const auto middle = order.begin() + static_cast<std::ptrdiff_t>(sorted);
+  std::sort(middle, order.end(), by_name);
+  std::inplace_merge(order.begin(), middle, order.end(), by_name);
+}
+
+// Merged histogram of all threads. buckets points to LogLinearBuckets::count non-cumulative bucket counts.
+struct HistogramSnapshot {
+  const std::uint64_t *buckets;
+  std::uint64_t sum;
+  std::uint64_t count;
+};
+
+// Exports hand each metric kind to func as Measurements sorted by name. Values are summed per id into flat arrays, so
+// an export does not hash any name.
+class MeterImpl {
+public:
   template <typename F> void Export(F &&func) {
-    std::uint64_t &total_losts{counters_[string_view{"measurement_losts"}]};
-    total_losts = 0;
+    const std::uint32_t size{names_.Size()};
+
+    totals_.assign(size, 0U);
+    storage_.Export([&totals = totals_](const std::int32_t /*unused*/, const CounterSlots &s) { s.AddTo(totals); });
+
+    ExtendSortedOrder(names_, size, counter_order_);
+    counters_.clear();
+    for (const std::uint32_t id : counter_order_) {
+      counters_.push_back(Measurement<std::uint64_t>{names_.Get(id), totals_[id]});
+    }
+
+    std::forward<F>(func)(Measurements<std::uint64_t>{counters_.data(), counters_.size()});
+  }
+
+  template <typename F> void ExportHistograms(F &&func) {
+    const std::uint32_t size{std::min(histogram_names_.Size(), max_histograms)};
+
+    histogram_totals_.assign(std::size_t{size} * histogram_slots, 0U);
+    histogram_storage_.Export([&totals = histogram_totals_](const std::int32_t /*unused*/, const HistogramSlots &s) {
+      s.AddTo(totals);
+    });
+
+    ExtendSortedOrder(histogram_names_, size, histogram_order_);
+    histograms_.clear();
+    for (const std::uint32_t id : histogram_order_) {
+      const std::uint64_t *const buckets{&histogram_totals_[std::size_t{id} * histogram_slots]};
+      std::uint64_t count{0U};
+      for (std::uint32_t j{0U}; j < LogLinearBuckets::count; ++j) {
+        count += buckets[j];
+      }
+      histograms_.push_back(Measurement<HistogramSnapshot>{
+          histogram_names_.Get(id), HistogramSnapshot{buckets, buckets[histogram_sum_slot], count}});
+    }
+
+    std::forward<F>(func)(Measurements<HistogramSnapshot>{histograms_.data(), histograms_.size()});
+  }
 
-    storage_.Export([&total_losts, &v = counters_](const std::int32_t /*unused*/, Measurements &m) {
-      total_losts += m.Losts();
-      m.ConsumeAll([&v](const Measurement &m) { v[m.id->Get()] += m.value; });
+  // A gauge is the newest Set() of any thread plus the Add()s of all threads since, as ordered by GaugeSlots. An Add()
+  // racing with a Set() of another thread may count on either side of it.
+  template <typename F> void ExportGauges(F &&func) {
+    const std::uint32_t size{std::min(gauge_names_.Size(), std::uint32_t{GaugeSlots::max_gauges})};
+
+    gauge_states_.resize(size);
+    gauge_adds_.clear();
+    gauge_storage_.Export([this, size](const std::int32_t /*unused*/, const GaugeSlots &s) {
+      GaugeSlots::Record r{};
+      for (std::uint32_t i{0U}; i < size; ++i) {
+        if (!s.Read(i, r)) {
+          continue;
+        }
+        GaugeState &g{gauge_states_[i]};
+        if (r.stamp > g.stamp) {
+          g.stamp = r.stamp;
+          g.value = r.value;
+        }
+        gauge_adds_.push_back(GaugeAdds{i, r.seen, r.delta - r.delta_at_seen});
+      }
     });
 
-    std::forward<F>(func)(static_cast<const std::unordered_map<string_view, std::uint64_t> &>(counters_));
+    // Only the Add()s of threads which knew of the newest Set() follow it.
+    gauge_values_.assign(size, 0);
+    for (std::uint32_t i{0U}; i < size; ++i) {
+      gauge_values_[i] = static_cast<std::int64_t>(gauge_states_[i].value);
+    }
+    for (const GaugeAdds &a : gauge_adds_) {
+      if (a.seen >= gauge_states_[a.id].stamp) {
+        gauge_values_[a.id] += static_cast<std::int64_t>(a.since_seen);
+      }
+    }
+
+    ExtendSortedOrder(gauge_names_, size, gauge_order_);
+    gauges_.clear();
+    for (const std::uint32_t id : gauge_order_) {
+      gauges_.push_back(Measurement<std::int64_t>{gauge_names_.Get(id), gauge_values_[id]});
+    }
+
+    std::forward<F>(func)(Measurements<std::int64_t>{gauges_.data(), gauges_.size()});
+  }
+
+  // Labeled counters sorted by name and labels; the name of each measurement is the name of its family.
+  template <typename F> void ExportLabeledCounters(F &&func) {
+    series_totals_.assign(series_.Size(), 0U);
+    series_storage_.Export(
+        [&totals = series_totals_](const std::int32_t /*unused*/, const SeriesSlots &s) { s.AddTo(totals); });
+
+    labeled_.clear();
+    series_.Collect(series_totals_, labeled_);
+
+    std::forward<F>(func)(Measurements<LabeledValue>{labeled_.data(), labeled_.size()});
+  }
+
+  CounterSlots *PerThreadCounters() { return storage_.PerThreadEvents(); }
+  SeriesSlots *PerThreadSeries() { return series_storage_.PerThreadEvents(); }
+  HistogramSlots *PerThreadHistograms() { return histogram_storage_.PerThreadEvents(); }
+  GaugeSlots *PerThreadGauges() { return gauge_storage_.PerThreadEvents(); }
+  // Stamp of the newest Set() of gauge id by any thread, see GaugeSlots.
+  std::atomic<std::int64_t> &LastGaugeSet(const std::uint32_t id) { return gauge_sets_[id]; }
+
+  std::uint32_t RegisterName(const string_view name) { return names_.Register(name); }
+
+  // Throws std::length_error when more than max_histograms names are registered.
+  std::uint32_t RegisterHistogram(const string_view name) {
+    const std::uint32_t id{histogram_names_.Register(name)};
+    if (id >= max_histograms) {
+      throw std::length_error{"too many histograms"};
+    }
+    return id;
   }
 
-  Measurements *PerThreadEvents() { return storage_.PerThreadEvents(); }
+  std::uint32_t RegisterCounterFamily(const string_view name, const std::uint32_t cardinality) {
+    return series_.RegisterFamily(name, cardinality);
+  }
+  std::uint32_t RegisterSeries(const std::uint32_t family, const std::initializer_list<Label> labels) {
+    return series_.Register(family, labels);
+  }
 
-  const FixedString<64> *RegisterName(const string_view name) {
-    std::lock_guard<std::mutex> guard{register_names_};
-    return &(*names_.emplace(name).first);
+  // Throws std::length_error when more than GaugeSlots::max_gauges names are registered.
+  std::uint32_t RegisterGauge(const string_view name) {
+    const std::uint32_t id{gauge_names_.Register(name)};
+    if (id >= GaugeSlots::max_gauges) {
+      throw std::length_error{"too many gauges"};
+    }
+    return id;
   }
 
 private:
-  std::mutex register_names_;
-  std::set<FixedString<64>> names_;
-  std::unordered_map<string_view, std::uint64_t> counters_;
-  ThreadStorage<Measurements> storage_;
+  // Newest Set() seen so far; kept across exports as the thread which set it may be gone.
+  struct GaugeState {
+    std::int64_t stamp{0};
+    std::uint64_t value{0U};
+  };
+
+  // The sum of the Add()s of a thread since the newest Set() it knew of.
+  struct GaugeAdds {
+    std::uint32_t id;
+    std::int64_t seen;
+    std::uint64_t since_seen;
+  };
+
+  NameTable names_;
+  std::vector<std::uint64_t> totals_;
+  std::vector<std::uint32_t> counter_order_;
+  std::vector<Measurement<std::uint64_t>> counters_;
+  ThreadStorage<CounterSlots> storage_;
+
+  SeriesTable series_;
+  std::vector<std::uint64_t> series_totals_;
+  std::vector<Measurement<LabeledValue>> labeled_;
+  ThreadStorage<SeriesSlots> series_storage_;
+
+  NameTable histogram_names_;
+  std::vector<std::uint64_t> histogram_totals_;
+  std::vector<std::uint32_t> histogram_order_;
+  std::vector<Measurement<HistogramSnapshot>> histograms_;
+  ThreadStorage<HistogramSlots> histogram_storage_;
+
+  NameTable gauge_names_;
+  std::unique_ptr<std::atomic<std::int64_t>[]> gauge_sets_{new std::atomic<std::int64_t>[GaugeSlots::max_gauges]{}};
+  std::vector<GaugeState> gauge_states_;
+  std::vector<GaugeAdds> gauge_adds_;
+  std::vector<std::int64_t> gauge_values_;
+  std::vector<std::uint32_t> gauge_order_;
+  std::vector<Measurement<std::int64_t>> gauges_;
+  ThreadStorage<GaugeSlots> gauge_storage_;
 };
 
 inline MeterImpl &Meter() {
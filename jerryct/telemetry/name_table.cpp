@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/name_table.h"
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+namespace jerryct {
+namespace telemetry {
+
+constexpr std::uint32_t NameTable::chunk_size_;
+constexpr std::uint32_t NameTable::max_chunks_;
+constexpr std::uint32_t NameTable::index_size_;
+constexpr std::uint32_t NameTable::capacity;
+constexpr std::uint32_t NameTable::not_found;
+
+NameTable::NameTable()
+    : index_{static_cast<std::atomic<std::uint32_t> *>(std::calloc(index_size_, sizeof(std::uint32_t)))} {
+  if (index_ == nullptr) {
+    throw std::bad_alloc{};
+  }
+}
+
+std::uint32_t NameTable::Probe(const string_view truncated, std::uint32_t &id) const {
+  // Eight bytes per multiplication; names are usually hashed on every span.
+  std::uint64_t h{truncated.size()};
+  std::size_t i{0U};
+  for (; (i + sizeof(std::uint64_t)) <= truncated.size(); i += sizeof(std::uint64_t)) {
+    std::uint64_t word{};
+    std::memcpy(&word, truncated.data() + i, sizeof(word));
+    h = (h ^ word) * 0x9E3779B97F4A7C15U;
+  }
+  if (i < truncated.size()) {
+    std::uint64_t word{};
+    std::memcpy(&word, truncated.data() + i, truncated.size() - i);
+    h = (h ^ word) * 0x9E3779B97F4A7C15U;
+  }
+  const auto hash = static_cast<std::uint32_t>(h >> 32U);
+
+  // At most half of the index is in use, so there is always an empty slot to stop at.
+  for (std::uint32_t slot{hash & (index_size_ - 1U)};; slot = (slot + 1U) & (index_size_ - 1U)) {
+    const std::uint32_t value{index_.get()[slot].load(std::memory_order_acquire)};
+    if (value == 0U) {
+      id = not_found;
+      return slot;
+    }
+    if (Get(value - 1U) == truncated) {
+      id = value - 1U;
+      return slot;
+    }
+  }
+}
+
+std::uint32_t NameTable::Find(const string_view name) const {
+  std::uint32_t id{};
+  Probe(Truncate(name), id);
+  return id;
+}
+
+std::uint32_t NameTable::Register(const string_view name) {
+  const string_view truncated{Truncate(name)};
+
+  std::uint32_t id{};
+  Probe(truncated, id);
+  if (id != not_found) {
+    return id;
+  }
+
+  std::lock_guard<std::mutex> guard{register_names_};
+
+  const std::uint32_t slot{Probe(truncated, id)};
+  if (id != not_found) {
+    return id;
+  }
+
+  id = size_.load(std::memory_order_relaxed);
+  if (id == capacity) {
+    throw std::length_error{"too many names"};
+  }
+
+  auto &chunk = chunks_[id / chunk_size_];
+  if (chunk == nullptr) {
+    chunk.reset(new FixedString<64>[chunk_size_]);
+  }
+
+  chunk[id % chunk_size_] = FixedString<64>{truncated};
+  size_.store(id + 1U, std::memory_order_release);
+  index_.get()[slot].store(id + 1U, std::memory_order_release);
+
+  return id;
+}
+
+} // namespace telemetry
+} // namespace jerryct
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: MIT
+
+#ifndef JERRYCT_TELEMETRY_NAME_TABLE_H
+#define JERRYCT_TELEMETRY_NAME_TABLE_H
+
+#include "jerryct/string_view.h"
+#include "jerryct/telemetry/fixed_string.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+
+namespace jerryct {
+namespace telemetry {
+
+// Interns names into small, dense ids. Ids are handed out in registration order starting at 0 and stay valid for the
+// lifetime of the table. Get() does not lock: the storage of a name never moves once registered and the id itself is
+// only obtained through Register(), which orders the write of the name before any use of its id. Looking up a name
+// which is already registered does not lock either: an open-addressing index of ids is published slot by slot after
+// the name was written, so only new names take the mutex.
+class NameTable {
+  static constexpr std::uint32_t chunk_size_{1024U};
+  static constexpr std::uint32_t max_chunks_{256U};
+  static constexpr std::uint32_t index_size_{2U * chunk_size_ * max_chunks_};
+
+public:
+  static constexpr std::uint32_t capacity{chunk_size_ * max_chunks_};
+  static constexpr std::uint32_t not_found{0xFFFFFFFFU};
+
+  NameTable();
+  NameTable(const NameTable &) = delete;
+  NameTable(NameTable &&) = delete;
+  NameTable &operator=(const NameTable &) = delete;
+  NameTable &operator=(NameTable &&) = delete;
+  ~NameTable() noexcept = default;
+
+  std::uint32_t Register(const string_view name);
+  // The id of a registered name or not_found. Never locks.
+  std::uint32_t Find(const string_view name) const;
+  string_view Get(const std::uint32_t id) const { return chunks_[id / chunk_size_][id % chunk_size_].Get(); }
+  // Names with an id below Size() can be read with Get() from any thread.
+  std::uint32_t Size() const { return size_.load(std::memory_order_acquire); }
+
+private:
+  struct Free {
+    void operator()(std::atomic<std::uint32_t> *p) const noexcept { std::free(p); }
+  };
+
+  static string_view Truncate(const string_view name) { return name.substr(0U, FixedString<64>::Size()); }
+  // The index slot holding the id of name, or the empty slot where it belongs. Slots hold id + 1, 0 if empty.
+  std::uint32_t Probe(const string_view truncated, std::uint32_t &id) const;
+
+  std::mutex register_names_;
+  std::atomic<std::uint32_t> size_{0U};
+  // Zeroed memory from calloc is only backed by pages once a name is hashed into it.
+  const std::unique_ptr<std::atomic<std::uint32_t>, Free> index_;
+  std::array<std::unique_ptr<FixedString<64>[]>, max_chunks_> chunks_;
+};
+
+} // namespace telemetry
+} // namespace jerryct
+
+#endif // JERRYCT_TELEMETRY_NAME_TABLE_H
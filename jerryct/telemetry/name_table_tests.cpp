@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/name_table.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace jerryct {
+namespace telemetry {
+namespace {
+
+TEST(NameTableTest, WhenRegistered_ExpectFound) {
+  NameTable names{};
+  EXPECT_EQ(NameTable::not_found, names.Find("main"));
+
+  const std::uint32_t id{names.Register("main")};
+  EXPECT_EQ(id, names.Find("main"));
+  EXPECT_EQ(id, names.Register("main"));
+  EXPECT_EQ(NameTable::not_found, names.Find("mai"));
+}
+
+TEST(NameTableTest, WhenLongName_ExpectFoundByTruncatedName) {
+  NameTable names{};
+  const std::uint32_t id{names.Register(std::string(80, 'c'))};
+
+  EXPECT_EQ(id, names.Find(std::string(64, 'c')));
+  EXPECT_EQ(id, names.Find(std::string(70, 'c')));
+}
+
+TEST(NameTableTest, WhenRegisteredConcurrently_ExpectOneIdPerName) {
+  NameTable names{};
+  std::vector<std::vector<std::uint32_t>> ids(4U);
+  std::vector<std::thread> threads{};
+  for (std::vector<std::uint32_t> &v : ids) {
+    threads.emplace_back([&names, &v]() {
+      for (std::int32_t i{0}; i < 1000; ++i) {
+        v.push_back(names.Register("name " + std::to_string(i)));
+      }
+    });
+  }
+  for (std::thread &t : threads) {
+    t.join();
+  }
+
+  EXPECT_EQ(1000U, names.Size());
+  for (const std::vector<std::uint32_t> &v : ids) {
+    EXPECT_EQ(ids[0U], v);
+  }
+  for (std::size_t i{0U}; i < ids[0U].size(); ++i) {
+    const string_view name{names.Get(ids[0U][i])};
+    EXPECT_EQ("name " + std::to_string(i), std::string(name.data(), name.size()));
+  }
+}
+
+} // namespace
+} // namespace telemetry
+} // namespace jerryct
@@ -7,19 +7,106 @@
 namespace jerryct {
 namespace telemetry {
 
-void OpenMetricsExporter::operator()(const std::unordered_map<string_view, std::uint64_t> &counters) {
-  content_.reserve(1024U);
-  content_.clear();
+void OpenMetricsExporter::operator()(const Measurements<std::uint64_t> &counters) {
+  counters_.reserve(1024U);
+  counters_.clear();
 
   for (const auto &c : counters) {
-    content_.append(fmt::string_view{"# TYPE "});
-    content_.append(c.first);
-    content_.append(fmt::string_view{" counter\n"});
-    content_.append(c.first);
-    content_.append(fmt::string_view{"_total "});
-    content_.append(fmt::format_int{c.second});
-    content_.push_back('\n');
+    counters_.append(fmt::string_view{"# TYPE "});
+    counters_.append(c.name);
+    counters_.append(fmt::string_view{" counter\n"});
+    counters_.append(c.name);
+    counters_.append(fmt::string_view{"_total "});
+    counters_.append(fmt::format_int{c.value});
+    counters_.push_back('\n');
+  }
+
+  Render();
+}
+
+void OpenMetricsExporter::operator()(const Measurements<std::int64_t> &gauges) {
+  gauges_.clear();
+
+  for (const auto &g : gauges) {
+    gauges_.append(fmt::string_view{"# TYPE "});
+    gauges_.append(g.name);
+    gauges_.append(fmt::string_view{" gauge\n"});
+    gauges_.append(g.name);
+    gauges_.push_back(' ');
+    gauges_.append(fmt::format_int{g.value});
+    gauges_.push_back('\n');
+  }
+
+  Render();
+}
+
+void OpenMetricsExporter::operator()(const Measurements<LabeledValue> &labeled) {
+  labeled_.clear();
+
+  string_view family{};
+  for (const auto &l : labeled) {
+    if (l.name != family) {
+      family = l.name;
+      labeled_.append(fmt::string_view{"# TYPE "});
+      labeled_.append(l.name);
+      labeled_.append(fmt::string_view{" counter\n"});
+    }
+    labeled_.append(l.name);
+    labeled_.append(fmt::string_view{"_total{"});
+    labeled_.append(l.value.labels);
+    labeled_.append(fmt::string_view{"} "});
+    labeled_.append(fmt::format_int{l.value.value});
+    labeled_.push_back('\n');
   }
+
+  Render();
+}
+
+void OpenMetricsExporter::operator()(const Measurements<HistogramSnapshot> &histograms) {
+  histograms_.clear();
+
+  for (const auto &h : histograms) {
+    histograms_.append(fmt::string_view{"# TYPE "});
+    histograms_.append(h.name);
+    histograms_.append(fmt::string_view{" histogram\n"});
+
+    std::uint64_t cumulative{0U};
+    for (std::uint32_t i{0U}; i < LogLinearBuckets::count; ++i) {
+      if (h.value.buckets[i] == 0U) {
+        continue;
+      }
+      cumulative += h.value.buckets[i];
+      histograms_.append(h.name);
+      histograms_.append(fmt::string_view{"_bucket{le=\""});
+      histograms_.append(fmt::format_int{LogLinearBuckets::UpperBound(i)});
+      histograms_.append(fmt::string_view{"\"} "});
+      histograms_.append(fmt::format_int{cumulative});
+      histograms_.push_back('\n');
+    }
+    histograms_.append(h.name);
+    histograms_.append(fmt::string_view{"_bucket{le=\"+Inf\"} "});
+    histograms_.append(fmt::format_int{h.value.count});
+    histograms_.push_back('\n');
+
+    histograms_.append(h.name);
+    histograms_.append(fmt::string_view{"_sum "});
+    histograms_.append(fmt::format_int{h.value.sum});
+    histograms_.push_back('\n');
+    histograms_.append(h.name);
+    histograms_.append(fmt::string_view{"_count "});
+    histograms_.append(fmt::format_int{h.value.count});
+    histograms_.push_back('\n');
+  }
+
+  Render();
+}
+
+void OpenMetricsExporter::Render() {
+  content_.clear();
+  content_.append(fmt::string_view{counters_.data(), counters_.size()});
+  content_.append(fmt::string_view{labeled_.data(), labeled_.size()});
+  content_.append(fmt::string_view{gauges_.data(), gauges_.size()});
+  content_.append(fmt::string_view{histograms_.data(), histograms_.size()});
 }
 
 void OpenMetricsExporter::Expose() {
@@ -5,19 +5,31 @@
 
 #include "jerryct/string_view.h"
 #include "jerryct/telemetry/http_server.h"
+#include "jerryct/telemetry/meter.h"
 #include <cstdint>
 #include <fmt/format.h>
-#include <unordered_map>
+#include <vector>
 
 namespace jerryct {
 namespace telemetry {
 
 class OpenMetricsExporter {
 public:
-  void operator()(const std::unordered_map<string_view, std::uint64_t> &counters);
+  void operator()(const Measurements<std::uint64_t> &counters);
+  void operator()(const Measurements<std::int64_t> &gauges);
+  // Expects the values sorted by name like MeterImpl::ExportLabeledCounters().
+  void operator()(const Measurements<LabeledValue> &labeled);
+  // Only buckets with recorded values are rendered, next to the +Inf bucket.
+  void operator()(const Measurements<HistogramSnapshot> &histograms);
   void Expose();
 
 private:
+  void Render();
+
+  fmt::memory_buffer counters_;
+  fmt::memory_buffer gauges_;
+  fmt::memory_buffer labeled_;
+  fmt::memory_buffer histograms_;
   fmt::memory_buffer content_;
 
   HttpServer server_{};
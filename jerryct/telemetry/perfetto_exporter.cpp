@@ -0,0 +1,411 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/perfetto_exporter.h"
+#include "jerryct/telemetry/varint.h"
+#include <chrono>
+#include <cstring>
+#include <time.h>
+#include <unistd.h>
+
+namespace jerryct {
+namespace telemetry {
+
+namespace {
+
+// Field numbers of protos/perfetto/trace/**.proto.
+namespace trace {
+constexpr std::uint32_t packet{1U};
+} // namespace trace
+
+namespace packet {
+constexpr std::uint32_t clock_snapshot{6U};
+constexpr std::uint32_t timestamp{8U};
+constexpr std::uint32_t trusted_packet_sequence_id{10U};
+constexpr std::uint32_t track_event{11U};
+constexpr std::uint32_t interned_data{12U};
+constexpr std::uint32_t sequence_flags{13U};
+constexpr std::uint32_t timestamp_clock_id{58U};
+constexpr std::uint32_t trace_packet_defaults{59U};
+constexpr std::uint32_t track_descriptor{60U};
+
+constexpr std::uint32_t seq_incremental_state_cleared{1U};
+constexpr std::uint32_t seq_needs_incremental_state{2U};
+} // namespace packet
+
+namespace defaults {
+constexpr std::uint32_t track_event_defaults{11U};
+constexpr std::uint32_t track_uuid{11U};
+} // namespace defaults
+
+namespace clock {
+constexpr std::uint32_t clocks{1U};
+constexpr std::uint32_t clock_id{1U};
+constexpr std::uint32_t timestamp{2U};
+constexpr std::uint32_t is_incremental{3U};
+
+constexpr std::uint32_t monotonic{3U};
+constexpr std::uint32_t boottime{6U};
+// Sequence-scoped clock ids start at 64.
+constexpr std::uint32_t incremental{64U};
+} // namespace clock
+
+namespace track {
+constexpr std::uint32_t uuid{1U};
+constexpr std::uint32_t name{2U};
+constexpr std::uint32_t process{3U};
+constexpr std::uint32_t thread{4U};
+constexpr std::uint32_t parent_uuid{5U};
+constexpr std::uint32_t counter{8U};
+
+constexpr std::uint32_t pid{1U};
+constexpr std::uint32_t tid{2U};
+constexpr std::uint32_t thread_name{5U};
+
+constexpr std::uint64_t process_kind{1ULL << 60U};
+constexpr std::uint64_t thread_kind{2ULL << 60U};
+constexpr std::uint64_t losts_kind{3ULL << 60U};
+constexpr std::uint64_t async_kind{4ULL << 60U};
+} // namespace track
+
+namespace event {
+constexpr std::uint32_t debug_annotations{4U};
+constexpr std::uint32_t type{9U};
+constexpr std::uint32_t name_iid{10U};
+constexpr std::uint32_t track_uuid{11U};
+constexpr std::uint32_t counter_value{30U};
+constexpr std::uint32_t flow_ids{47U};
+constexpr std::uint32_t terminating_flow_ids{48U};
+
+constexpr std::uint32_t slice_begin{1U};
+constexpr std::uint32_t slice_end{2U};
+constexpr std::uint32_t instant{3U};
+constexpr std::uint32_t counter{4U};
+} // namespace event
+
+namespace interned {
+constexpr std::uint32_t event_names{2U};
+constexpr std::uint32_t debug_annotation_names{3U};
+constexpr std::uint32_t iid{1U};
+constexpr std::uint32_t name{2U};
+} // namespace interned
+
+namespace annotation {
+constexpr std::uint32_t name_iid{1U};
+constexpr std::uint32_t uint_value{3U};
+constexpr std::uint32_t int_value{4U};
+constexpr std::uint32_t double_value{5U};
+constexpr std::uint32_t string_value{6U};
+} // namespace annotation
+
+void Tag(const std::uint32_t field, const std::uint32_t wire_type, std::vector<std::uint8_t> &buf) {
+  PutVarint((std::uint64_t{field} << 3U) | wire_type, buf);
+}
+
+void Varint(const std::uint32_t field, const std::uint64_t v, std::vector<std::uint8_t> &buf) {
+  Tag(field, 0U, buf);
+  PutVarint(v, buf);
+}
+
+void Fixed64(const std::uint32_t field, const std::uint64_t v, std::vector<std::uint8_t> &buf) {
+  Tag(field, 1U, buf);
+  for (std::uint32_t i{0U}; i < 8U; ++i) {
+    buf.push_back(static_cast<std::uint8_t>(v >> (8U * i)));
+  }
+}
+
+void Double(const std::uint32_t field, const double v, std::vector<std::uint8_t> &buf) {
+  std::uint64_t bits{};
+  std::memcpy(&bits, &v, sizeof(bits));
+  Fixed64(field, bits, buf);
+}
+
+void String(const std::uint32_t field, const string_view s, std::vector<std::uint8_t> &buf) {
+  Tag(field, 2U, buf);
+  PutVarint(s.size(), buf);
+  buf.insert(buf.end(), s.begin(), s.end());
+}
+
+// Nested messages are written in place; Close() inserts the size in front once it is known.
+std::size_t Open(const std::uint32_t field, std::vector<std::uint8_t> &buf) {
+  Tag(field, 2U, buf);
+  return buf.size();
+}
+
+void Close(const std::size_t start, std::vector<std::uint8_t> &buf) {
+  std::uint8_t size[10];
+  std::uint64_t v{buf.size() - start};
+  std::size_t n{0U};
+  while (v >= 0x80U) {
+    size[n++] = static_cast<std::uint8_t>(v | 0x80U);
+    v >>= 7U;
+  }
+  size[n++] = static_cast<std::uint8_t>(v);
+  buf.insert(buf.begin() + static_cast<std::ptrdiff_t>(start), size, size + n);
+}
+
+std::uint64_t Nanoseconds(const std::chrono::steady_clock::time_point tp) {
+  const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch());
+  return static_cast<std::uint64_t>(ns.count());
+}
+
+// CLOCK_BOOTTIME runs ahead of CLOCK_MONOTONIC, which backs steady_clock, by the time spent in suspend.
+std::uint64_t BoottimeOffset() {
+  timespec monotonic{};
+  timespec boottime{};
+  ::clock_gettime(CLOCK_MONOTONIC, &monotonic);
+  ::clock_gettime(CLOCK_BOOTTIME, &boottime);
+  const std::int64_t offset{(std::int64_t{boottime.tv_sec} - std::int64_t{monotonic.tv_sec}) * 1000000000 +
+                            (boottime.tv_nsec - monotonic.tv_nsec)};
+  return offset > 0 ? static_cast<std::uint64_t>(offset) : 0U;
+}
+
+bool Intern(const std::uint32_t id, std::vector<bool> &interned) {
+  if (id >= interned.size()) {
+    interned.resize(id + 1U, false);
+  }
+  if (interned[id]) {
+    return false;
+  }
+  interned[id] = true;
+  return true;
+}
+
+} // namespace
+
+PerfettoExporter::PerfettoExporter(const std::string &filename, const FileSinkOptions &options)
+    : f_{filename, options}, pid_{static_cast<std::uint64_t>(::getpid())} {}
+
+void PerfettoExporter::operator()(const std::int32_t tid, const std::uint64_t losts, const Segments<Event> &events,
+                                  const NameTable &names, const TimeBase &time_base) {
+  if (events.empty()) {
+    return;
+  }
+
+  auto it = sequences_.find(tid);
+  if (it == sequences_.end()) {
+    it = sequences_.emplace(tid, Sequence{}).first;
+    Start(it->second, tid, Nanoseconds(time_base.ToTimePoint(events.begin()->time_stamp)));
+  }
+  Sequence &s{it->second};
+
+  for (const Event &e : events) {
+    // Meaningless for arguments, which carry their value in time_stamp.
+    const std::uint64_t time{Nanoseconds(time_base.ToTimePoint(e.time_stamp))};
+    switch (e.phase) {
+    case Phase::begin:
+      WriteTrackEvent(s, time, Slice{event::slice_begin, e.name, 0U, 0U, 0U, false}, names);
+      break;
+    case Phase::end:
+      WriteTrackEvent(s, time, Slice{event::slice_end, 0U, 0U, 0U, 0U, true}, names);
+      break;
+    case Phase::complete:
+      WriteTrackEvent(s, time, Slice{event::slice_begin, e.name, 0U, 0U, 0U, false}, names);
+      WriteTrackEvent(s, time + static_cast<std::uint64_t>(time_base.ToDuration(e.duration).count()),
+                      Slice{event::slice_end, 0U, 0U, 0U, 0U, true}, names);
+      break;
+    case Phase::async_begin: {
+      const std::uint64_t uuid{track::async_kind | e.duration};
+      const std::size_t p{Open(trace::packet, buf_)};
+      Varint(packet::trusted_packet_sequence_id, s.id, buf_);
+      const std::size_t d{Open(packet::track_descriptor, buf_)};
+      Varint(track::uuid, uuid, buf_);
+      Varint(track::parent_uuid, track::process_kind | pid_, buf_);
+      String(track::name, names.Get(e.name), buf_);
+      Close(d, buf_);
+      Close(p, buf_);
+      WriteTrackEvent(s, time, Slice{event::slice_begin, e.name, uuid, 0U, 0U, false}, names);
+    } break;
+    case Phase::async_end:
+      WriteTrackEvent(s, time, Slice{event::slice_end, 0U, track::async_kind | e.duration, 0U, 0U, false}, names);
+      break;
+    case Phase::flow_start:
+      WriteTrackEvent(s, time, Slice{event::instant, e.name, 0U, event::flow_ids, e.duration, false}, names);
+      break;
+    case Phase::flow_end:
+      WriteTrackEvent(s, time, Slice{event::instant, e.name, 0U, event::terminating_flow_ids, e.duration, false},
+                      names);
+      break;
+    case Phase::arg_int:
+    case Phase::arg_uint:
+    case Phase::arg_double:
+    case Phase::arg_string:
+      s.args.push_back(e);
+      break;
+    }
+  }
+
+  if (losts != s.losts) {
+    total_losts_ += losts - s.losts;
+    s.losts = losts;
+    const std::size_t p{Open(trace::packet, buf_)};
+    WriteTimestamp(s, s.time);
+    Varint(packet::trusted_packet_sequence_id, s.id, buf_);
+    Varint(packet::sequence_flags, packet::seq_needs_incremental_state, buf_);
+    const std::size_t t{Open(packet::track_event, buf_)};
+    Varint(event::type, event::counter, buf_);
+    Varint(event::track_uuid, track::losts_kind | pid_, buf_);
+    Varint(event::counter_value, total_losts_, buf_);
+    Close(t, buf_);
+    Close(p, buf_);
+  }
+
+  f_.Write(buf_.data(), buf_.size());
+  buf_.clear();
+}
+
+void PerfettoExporter::Start(Sequence &s, const std::int32_t tid, const std::uint64_t time) {
+  if (!process_written_) {
+    WriteProcess();
+  }
+
+  s.id = static_cast<std::uint32_t>(tid) + 1U;
+  s.track = track::thread_kind | static_cast<std::uint32_t>(tid);
+  s.time = time;
+  s.losts = 0U;
+
+  // Clears the incremental state and binds the incremental clock of the sequence to the steady clock.
+  std::size_t p{Open(trace::packet, buf_)};
+  Varint(packet::trusted_packet_sequence_id, s.id, buf_);
+  Varint(packet::sequence_flags, packet::seq_incremental_state_cleared, buf_);
+  const std::size_t d{Open(packet::trace_packet_defaults, buf_)};
+  Varint(packet::timestamp_clock_id, clock::incremental, buf_);
+  const std::size_t te{Open(defaults::track_event_defaults, buf_)};
+  Varint(defaults::track_uuid, s.track, buf_);
+  Close(te, buf_);
+  Close(d, buf_);
+  const std::size_t c{Open(packet::clock_snapshot, buf_)};
+  const std::uint64_t boottime{time + BoottimeOffset()};
+  for (const std::uint32_t id : {clock::boottime, clock::monotonic, clock::incremental}) {
+    const std::size_t k{Open(clock::clocks, buf_)};
+    Varint(clock::clock_id, id, buf_);
+    Varint(clock::timestamp, id == clock::boottime ? boottime : time, buf_);
+    if (id == clock::incremental) {
+      Varint(clock::is_incremental, 1U, buf_);
+    }
+    Close(k, buf_);
+  }
+  Close(c, buf_);
+  Close(p, buf_);
+
+  p = Open(trace::packet, buf_);
+  Varint(packet::trusted_packet_sequence_id, s.id, buf_);
+  const std::size_t t{Open(packet::track_descriptor, buf_)};
+  Varint(track::uuid, s.track, buf_);
+  const std::size_t th{Open(track::thread, buf_)};
+  Varint(track::pid, pid_, buf_);
+  // tid 0 is reserved for the idle task.
+  Varint(track::tid, static_cast<std::uint64_t>(tid) + 1U, buf_);
+  String(track::thread_name, "thread " + std::to_string(tid), buf_);
+  Close(th, buf_);
+  Close(t, buf_);
+  Close(p, buf_);
+}
+
+void PerfettoExporter::WriteProcess() {
+  process_written_ = true;
+
+  std::size_t p{Open(trace::packet, buf_)};
+  std::size_t t{Open(packet::track_descriptor, buf_)};
+  Varint(track::uuid, track::process_kind | pid_, buf_);
+  const std::size_t pr{Open(track::process, buf_)};
+  Varint(track::pid, pid_, buf_);
+  Close(pr, buf_);
+  Close(t, buf_);
+  Close(p, buf_);
+
+  p = Open(trace::packet, buf_);
+  t = Open(packet::track_descriptor, buf_);
+  Varint(track::uuid, track::losts_kind | pid_, buf_);
+  Varint(track::parent_uuid, track::process_kind | pid_, buf_);
+  String(track::name, "total lost events", buf_);
+  Close(Open(track::counter, buf_), buf_);
+  Close(t, buf_);
+  Close(p, buf_);
+}
+
+void PerfettoExporter::WriteTrackEvent(Sequence &s, const std::uint64_t time, const Slice &slice,
+                                       const NameTable &names) {
+  const std::size_t p{Open(trace::packet, buf_)};
+  WriteTimestamp(s, time);
+  Varint(packet::trusted_packet_sequence_id, s.id, buf_);
+  Varint(packet::sequence_flags, packet::seq_needs_incremental_state, buf_);
+
+  const bool new_name{(slice.name != 0U) && Intern(slice.name, s.names)};
+  bool new_keys{false};
+  if (slice.with_args) {
+    for (const Event &a : s.args) {
+      new_keys = Intern(a.name, s.keys) || new_keys;
+    }
+  }
+  if (new_name || new_keys) {
+    // Interning entries twice does no harm, hence all keys of the slice are written when one is new.
+    const std::size_t i{Open(packet::interned_data, buf_)};
+    if (new_name) {
+      const std::size_t n{Open(interned::event_names, buf_)};
+      Varint(interned::iid, slice.name, buf_);
+      String(interned::name, names.Get(slice.name), buf_);
+      Close(n, buf_);
+    }
+    if (new_keys) {
+      for (const Event &a : s.args) {
+        const std::size_t n{Open(interned::debug_annotation_names, buf_)};
+        Varint(interned::iid, a.name, buf_);
+        String(interned::name, names.Get(a.name), buf_);
+        Close(n, buf_);
+      }
+    }
+    Close(i, buf_);
+  }
+
+  const std::size_t t{Open(packet::track_event, buf_)};
+  Varint(event::type, slice.type, buf_);
+  if (slice.track != 0U) {
+    Varint(event::track_uuid, slice.track, buf_);
+  }
+  if (slice.name != 0U) {
+    Varint(event::name_iid, slice.name, buf_);
+  }
+  if (slice.flow_field != 0U) {
+    Fixed64(slice.flow_field, slice.flow, buf_);
+  }
+  if (slice.with_args) {
+    for (const Event &a : s.args) {
+      const std::size_t d{Open(event::debug_annotations, buf_)};
+      Varint(annotation::name_iid, a.name, buf_);
+      switch (a.phase) {
+      case Phase::arg_int:
+        Tag(annotation::int_value, 0U, buf_);
+        PutVarint(static_cast<std::uint64_t>(ArgInt(a)), buf_);
+        break;
+      case Phase::arg_uint:
+        Varint(annotation::uint_value, ArgUint(a), buf_);
+        break;
+      case Phase::arg_double:
+        Double(annotation::double_value, ArgDouble(a), buf_);
+        break;
+      default: {
+        char bytes[max_arg_string];
+        String(annotation::string_value, ArgString(a, bytes), buf_);
+      } break;
+      }
+      Close(d, buf_);
+    }
+    s.args.clear();
+  }
+  Close(t, buf_);
+
+  Close(p, buf_);
+}
+
+void PerfettoExporter::WriteTimestamp(Sequence &s, const std::uint64_t time) {
+  if (time >= s.time) {
+    Varint(packet::timestamp, time - s.time, buf_);
+    s.time = time;
+  } else {
+    Varint(packet::timestamp, time, buf_);
+    Varint(packet::timestamp_clock_id, clock::monotonic, buf_);
+  }
+}
+
+} // namespace telemetry
+} // namespace jerryct
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: MIT
+
+#ifndef JERRYCT_TELEMETRY_PERFETTO_EXPORTER_H
+#define JERRYCT_TELEMETRY_PERFETTO_EXPORTER_H
+
+#include "jerryct/telemetry/file_sink.h"
+#include "jerryct/telemetry/tracer.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace jerryct {
+namespace telemetry {
+
+// Writes a Perfetto trace, i.e. a protobuf Trace message of TracePackets, for ui.perfetto.dev. The wire format is
+// encoded by hand. Each exported thread gets its own packet sequence and track. Event names and argument keys are
+// interned per sequence, and time stamps are deltas on an incremental clock. A time stamp going backwards, e.g. the
+// end of a complete event, is written absolutely. Total losts are a counter track of the process.
+class PerfettoExporter {
+public:
+  explicit PerfettoExporter(const std::string &filename, const FileSinkOptions &options = {});
+  PerfettoExporter(const PerfettoExporter &) = delete;
+  PerfettoExporter &operator=(const PerfettoExporter &) = delete;
+  PerfettoExporter(PerfettoExporter &&other) = default;
+  PerfettoExporter &operator=(PerfettoExporter &&other) = default;
+  ~PerfettoExporter() noexcept = default;
+
+  void operator()(const std::int32_t tid, const std::uint64_t losts, const Segments<Event> &events,
+                  const NameTable &names, const TimeBase &time_base);
+
+private:
+  struct Sequence {
+    std::uint32_t id;
+    std::uint64_t track;
+    std::uint64_t time;
+    std::uint64_t losts;
+    std::vector<bool> names;
+    std::vector<bool> keys;
+    std::vector<Event> args;
+  };
+
+  struct Slice {
+    std::uint32_t type;
+    std::uint32_t name;
+    std::uint64_t track;
+    std::uint32_t flow_field;
+    std::uint64_t flow;
+    bool with_args;
+  };
+
+  void Start(Sequence &s, const std::int32_t tid, const std::uint64_t time);
+  void WriteProcess();
+  void WriteTrackEvent(Sequence &s, const std::uint64_t time, const Slice &slice, const NameTable &names);
+  void WriteTimestamp(Sequence &s, const std::uint64_t time);
+
+  FileSink f_;
+  std::vector<std::uint8_t> buf_;
+  std::unordered_map<std::int32_t, Sequence> sequences_;
+  std::uint64_t pid_;
+  bool process_written_{false};
+  std::uint64_t total_losts_{0U};
+};
+
+} // namespace telemetry
+} // namespace jerryct
+
+#endif // JERRYCT_TELEMETRY_PERFETTO_EXPORTER_H
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/perfetto_exporter.h"
+#include "jerryct/telemetry/span.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+void ExportPerfettoTrace(benchmark::State &state) {
+  jerryct::telemetry::PerfettoExporter perfetto{"test.pftrace"};
+
+  auto name = std::string(64, 'c');
+  for (auto _ : state) {
+    jerryct::telemetry::Span s{jerryct::telemetry::Tracer(), name};
+    jerryct::telemetry::Tracer().Export(perfetto);
+  }
+}
+
+BENCHMARK(ExportPerfettoTrace);
+
+} // namespace
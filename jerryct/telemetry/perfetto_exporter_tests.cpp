@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/perfetto_exporter.h"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <map>
+#include <string>
+#include <time.h>
+#include <tuple>
+#include <vector>
+
+namespace jerryct {
+namespace telemetry {
+namespace {
+
+struct Field {
+  std::uint32_t number;
+  std::uint64_t value;
+  std::string bytes;
+};
+
+std::uint64_t Varint(const std::string &data, std::size_t &pos) {
+  std::uint64_t v{0U};
+  for (std::uint32_t shift{0U}; pos < data.size(); shift += 7U) {
+    const auto b = static_cast<std::uint8_t>(data[pos++]);
+    v |= std::uint64_t{b & 0x7FU} << shift;
+    if ((b & 0x80U) == 0U) {
+      break;
+    }
+  }
+  return v;
+}
+
+std::vector<Field> Decode(const std::string &data) {
+  std::vector<Field> fields{};
+  std::size_t pos{0U};
+  while (pos < data.size()) {
+    const std::uint64_t tag{Varint(data, pos)};
+    Field f{static_cast<std::uint32_t>(tag >> 3U), 0U, {}};
+    switch (tag & 7U) {
+    case 0U:
+      f.value = Varint(data, pos);
+      break;
+    case 1U:
+      for (std::uint32_t i{0U}; i < 8U; ++i) {
+        f.value |= std::uint64_t{static_cast<std::uint8_t>(data[pos++])} << (8U * i);
+      }
+      break;
+    default: {
+      const std::uint64_t size{Varint(data, pos)};
+      f.bytes = data.substr(pos, size);
+      pos += size;
+    } break;
+    }
+    fields.push_back(f);
+  }
+  return fields;
+}
+
+const Field *Find(const std::vector<Field> &fields, const std::uint32_t number) {
+  for (const Field &f : fields) {
+    if (f.number == number) {
+      return &f;
+    }
+  }
+  return nullptr;
+}
+
+// type, name, absolute time stamp and debug annotations as key=value.
+using Slice = std::tuple<std::uint64_t, std::string, std::uint64_t, std::string>;
+
+struct Trace {
+  std::vector<Slice> slices;
+  std::size_t interned_names{0U};
+  std::uint64_t losts{0U};
+  // Time stamps of the last clock snapshot by clock id.
+  std::map<std::uint64_t, std::uint64_t> clocks;
+};
+
+Trace Export(const std::vector<std::vector<Event>> &batches, const std::uint64_t losts = 0U) {
+  NameTable names{};
+  names.Register("");
+  names.Register("main");
+  names.Register("foo");
+  names.Register("bytes");
+  {
+    PerfettoExporter exporter{"test.pftrace"};
+    for (const std::vector<Event> &events : batches) {
+      exporter(0, losts, Segments<Event>{Segment<Event>{events.data(), events.data() + events.size()}}, names,
+               TimeBase{});
+    }
+  }
+  std::ifstream f{"test.pftrace", std::ios::binary};
+  const std::string data{std::istreambuf_iterator<char>{f}, {}};
+  std::remove("test.pftrace");
+
+  Trace trace{};
+  std::map<std::uint64_t, std::string> event_names{};
+  std::map<std::uint64_t, std::string> keys{};
+  std::uint64_t time{0U};
+  for (const Field &p : Decode(data)) {
+    EXPECT_EQ(1U, p.number);
+    const std::vector<Field> packet{Decode(p.bytes)};
+    if (const Field *snapshot{Find(packet, 6U)}) {
+      for (const Field &c : Decode(snapshot->bytes)) {
+        const std::vector<Field> clock{Decode(c.bytes)};
+        trace.clocks[Find(clock, 1U)->value] = Find(clock, 2U)->value;
+        if (Find(clock, 1U)->value == 64U) {
+          time = Find(clock, 2U)->value;
+        }
+      }
+    }
+    if (const Field *interned{Find(packet, 12U)}) {
+      for (const Field &i : Decode(interned->bytes)) {
+        const std::vector<Field> entry{Decode(i.bytes)};
+        (i.number == 2U ? event_names : keys)[Find(entry, 1U)->value] = Find(entry, 2U)->bytes;
+        trace.interned_names += i.number == 2U ? 1U : 0U;
+      }
+    }
+    const Field *event{Find(packet, 11U)};
+    if (event == nullptr) {
+      continue;
+    }
+    std::uint64_t ts{Find(packet, 8U)->value};
+    if (Find(packet, 58U) == nullptr) {
+      time += ts;
+      ts = time;
+    }
+    const std::vector<Field> e{Decode(event->bytes)};
+    if (Find(e, 9U)->value == 4U) {
+      trace.losts = Find(e, 30U)->value;
+      continue;
+    }
+    std::string args{};
+    for (const Field &f : e) {
+      if (f.number == 4U) {
+        const std::vector<Field> a{Decode(f.bytes)};
+        args += keys[Find(a, 1U)->value] + "=" + std::to_string(Find(a, 3U)->value);
+      }
+    }
+    const Field *name{Find(e, 10U)};
+    trace.slices.emplace_back(Find(e, 9U)->value, name == nullptr ? "" : event_names[name->value], ts, args);
+  }
+  return trace;
+}
+
+TEST(PerfettoExporterTest, WhenSlicesExported_ExpectTrackEventsWithAbsoluteTimes) {
+  const Trace trace{Export({{Event{Phase::begin, 1U, 0U, 1000000}, MakeArg(3U, std::uint64_t{4096U}),
+                             Event{Phase::end, 0U, 0U, 1500000}, Event{Phase::complete, 2U, 100U, 1200000}}})};
+
+  const std::vector<Slice> expected{Slice{1U, "main", 1000000U, ""}, Slice{2U, "", 1500000U, "bytes=4096"},
+                                    Slice{1U, "foo", 1200000U, ""}, Slice{2U, "", 1200100U, ""}};
+  EXPECT_EQ(expected, trace.slices);
+}
+
+TEST(PerfettoExporterTest, WhenNameRepeats_ExpectInternedOnce) {
+  const Trace trace{Export({{Event{Phase::begin, 1U, 0U, 1000}, Event{Phase::end, 0U, 0U, 2000}},
+                            {Event{Phase::begin, 1U, 0U, 3000}, Event{Phase::end, 0U, 0U, 4000}}})};
+
+  EXPECT_EQ(4U, trace.slices.size());
+  EXPECT_EQ(1U, trace.interned_names);
+}
+
+TEST(PerfettoExporterTest, WhenEventsLost_ExpectLostCounter) {
+  const Trace trace{Export({{Event{Phase::begin, 1U, 0U, 1000}}}, 5U)};
+
+  EXPECT_EQ(5U, trace.losts);
+}
+
+TEST(PerfettoExporterTest, WhenSequenceStarts_ExpectBoottimeIncludingSuspend) {
+  timespec monotonic{};
+  timespec boottime{};
+  ::clock_gettime(CLOCK_MONOTONIC, &monotonic);
+  ::clock_gettime(CLOCK_BOOTTIME, &boottime);
+  const std::int64_t suspended{(std::int64_t{boottime.tv_sec} - std::int64_t{monotonic.tv_sec}) * 1000000000 +
+                               (boottime.tv_nsec - monotonic.tv_nsec)};
+
+  Trace trace{Export({{Event{Phase::begin, 1U, 0U, 1000}}})};
+
+  EXPECT_EQ(1000U, trace.clocks[3U]);
+  EXPECT_NEAR(static_cast<double>(suspended), static_cast<double>(trace.clocks[6U] - trace.clocks[3U]), 1e6);
+}
+
+} // namespace
+} // namespace telemetry
+} // namespace jerryct
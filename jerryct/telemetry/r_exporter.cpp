@@ -2,8 +2,10 @@
 
 #include "jerryct/telemetry/r_exporter.h"
 #include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <numeric>
+#include <utility>
 
 // https://cran.r-project.org/doc/manuals/r-patched/R-ints.html#Serialization-Formats
 // https://yetanothermathprogrammingconsultant.blogspot.com/2016/02/r-rdata-file-format.html
@@ -12,10 +14,6 @@
 // > hist(i, xlim=c(0.00015,0.00025), breaks= c(seq(0.00015,0.00025,by=0.000001),10))
 // $ hexdump -C export.rdata
 
-#include <fcntl.h>
-#include <sys/stat.h>
-#include <unistd.h>
-
 namespace {
 
 #pragma pack(push, 1)
@@ -39,8 +37,8 @@ struct rdata_sexptype_header_t {
   unsigned int padding : 4;
 };
 
-void BeginFile(int fd) {
-  write(fd, "RDX2\n", 5);
+void BeginFile(jerryct::telemetry::FileSink &f) {
+  f.Write("RDX2\n", 5);
 
   rdata_v2_header_t v2_header;
   v2_header.header[0] = 'B';
@@ -49,45 +47,45 @@ void BeginFile(int fd) {
   v2_header.reader_version = 197636;
   v2_header.writer_version = 131840;
 
-  write(fd, &v2_header, sizeof(v2_header));
+  f.Write(&v2_header, sizeof(v2_header));
 }
 
-void EndFile(int fd) {
+void EndFile(jerryct::telemetry::FileSink &f) {
   rdata_sexptype_header_t header{};
   header.type = 254; // PSEUDO_SXP_NIL
-  write(fd, &header, sizeof(header));
+  f.Write(&header, sizeof(header));
 }
 
-void Serialize(int fd, const std::string &n, const std::vector<double> &b) {
+void Serialize(jerryct::telemetry::FileSink &f, const std::string &n, const std::vector<double> &b) {
   { // LISTSXP object: whole thing is packaged in a dotted pair list
     const unsigned v = 1026;
-    write(fd, &v, sizeof(v));
+    f.Write(&v, sizeof(v));
   }
   { // SYMSXP object: symbol
     const unsigned v = 1;
-    write(fd, &v, sizeof(v));
+    f.Write(&v, sizeof(v));
   }
   { // CHARSXP object: string
     const unsigned v = 262153;
-    write(fd, &v, sizeof(v));
+    f.Write(&v, sizeof(v));
   }
   { // Length of string
     const int v = static_cast<int>(n.size());
-    write(fd, &v, sizeof(v));
+    f.Write(&v, sizeof(v));
   }
   { // String: symbol name
-    write(fd, n.data(), n.size());
+    f.Write(n.data(), n.size());
   }
   { // REALSXP: real vector
     const unsigned v = 14;
-    write(fd, &v, sizeof(v));
+    f.Write(&v, sizeof(v));
   }
   { // Length of vector
     const int v = static_cast<int>(b.size());
-    write(fd, &v, sizeof(v));
+    f.Write(&v, sizeof(v));
   }
   { // elements
-    write(fd, b.data(), b.size() * sizeof(double));
+    f.Write(b.data(), b.size() * sizeof(double));
   }
 }
 
@@ -96,50 +94,73 @@ void Serialize(int fd, const std::string &n, const std::vector<double> &b) {
 namespace jerryct {
 namespace telemetry {
 
-RExporter::RExporter(const std::string &filename) : fd_{open(filename.c_str(), O_CREAT | O_WRONLY, 0644)} {
-  if (-1 == fd_) {
-    throw;
-  }
-}
-
-RExporter::RExporter(RExporter &&other) noexcept : fd_{other.fd_} { other.fd_ = -1; }
+RExporter::RExporter(const std::string &filename, const FileSinkOptions &options) : f_{filename, options} {}
 
-RExporter &RExporter::operator=(RExporter &&other) noexcept {
-  if (fd_ != other.fd_) {
-    std::swap(fd_, other.fd_);
+RExporter &RExporter::operator=(RExporter &&other) {
+  if (this != &other) {
+    if (f_.IsOpen()) {
+      Finish();
+    }
+    data_ = std::move(other.data_);
+    stacks_ = std::move(other.stacks_);
+    f_ = std::move(other.f_);
   }
   return *this;
 }
 
 RExporter::~RExporter() noexcept {
-  if (-1 == fd_) {
+  if (!f_.IsOpen()) {
     return;
   }
+  try {
+    Finish();
+  } catch (...) {
+    // The file is lost; a destructor cannot report the error.
+  }
+}
 
-  BeginFile(fd_);
+void RExporter::Finish() {
+  BeginFile(f_);
 
   for (auto &itt : data_) {
-    Serialize(fd_, itt.first, itt.second);
+    Serialize(f_, itt.first, itt.second);
   }
 
-  EndFile(fd_);
-  close(fd_);
+  EndFile(f_);
+  f_.Close();
 }
 
-void RExporter::operator()(const std::int32_t tid, const std::uint64_t /*unused*/, const std::vector<Event> &events) {
+void RExporter::operator()(const std::int32_t tid, const std::uint64_t /*unused*/, const Segments<Event> &events,
+                           const NameTable &names, const TimeBase &time_base) {
   auto &stack = stacks_[tid];
   for (const Event &e : events) {
     switch (e.phase) {
     case Phase::begin:
-      stack.push_back({{e.name.Get().data(), e.name.Get().size()}, e.time_stamp});
+      stack.push_back({e.name, e.time_stamp});
       break;
     case Phase::end:
       if (!stack.empty()) {
-        const auto d = std::chrono::duration<double, std::milli>{e.time_stamp - stack.back().ts}.count();
-        data_[stack.back().name].push_back(d);
+        const auto d =
+            std::chrono::duration<double, std::milli>{time_base.ToDuration(e.time_stamp - stack.back().ts)}.count();
+        const string_view name{names.Get(stack.back().name)};
+        data_[{name.data(), name.size()}].push_back(d);
         stack.pop_back();
       }
       break;
+    case Phase::complete: {
+      const auto d = std::chrono::duration<double, std::milli>{time_base.ToDuration(e.duration)}.count();
+      const string_view name{names.Get(e.name)};
+      data_[{name.data(), name.size()}].push_back(d);
+    } break;
+    case Phase::async_begin:
+    case Phase::async_end:
+    case Phase::flow_start:
+    case Phase::flow_end:
+    case Phase::arg_int:
+    case Phase::arg_uint:
+    case Phase::arg_double:
+    case Phase::arg_string:
+      break;
     }
   }
 }
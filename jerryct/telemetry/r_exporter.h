@@ -3,8 +3,8 @@
 #ifndef JERRYCT_TELEMETRY_R_EXPORTER_H
 #define JERRYCT_TELEMETRY_R_EXPORTER_H
 
+#include "jerryct/telemetry/file_sink.h"
 #include "jerryct/telemetry/tracer.h"
-#include <chrono>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -12,27 +12,33 @@
 namespace jerryct {
 namespace telemetry {
 
+// Writes the durations of the spans per name as an R data file on destruction. An existing file is truncated.
 class RExporter {
 public:
-  explicit RExporter(const std::string &filename);
+  explicit RExporter(const std::string &filename, const FileSinkOptions &options = {});
   RExporter(const RExporter &) = delete;
-  RExporter(RExporter &&other) noexcept;
+  RExporter(RExporter &&other) noexcept = default;
   RExporter &operator=(const RExporter &) = delete;
-  RExporter &operator=(RExporter &&other) noexcept;
+  // Writes the file of this exporter before taking over the one of other.
+  RExporter &operator=(RExporter &&other);
+  // Writes the file; errors are ignored.
   ~RExporter() noexcept;
 
-  void operator()(const std::int32_t tid, const std::uint64_t /*unused*/, const std::vector<Event> &events);
+  void operator()(const std::int32_t tid, const std::uint64_t /*unused*/, const Segments<Event> &events,
+                  const NameTable &names, const TimeBase &time_base);
 
 private:
+  void Finish();
+
   struct Frame {
-    const std::string name;
-    const std::chrono::steady_clock::time_point ts;
+    const std::uint32_t name;
+    const std::int64_t ts;
   };
 
   std::unordered_map<std::string, std::vector<double>> data_;
   std::unordered_map<int, std::vector<Frame>> stacks_;
 
-  int fd_;
+  FileSink f_;
 };
 
 } // namespace telemetry
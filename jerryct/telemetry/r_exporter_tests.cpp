@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/r_exporter.h"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace jerryct {
+namespace telemetry {
+namespace {
+
+std::string Read(const std::string &filename) {
+  std::ifstream i{filename, std::ios::binary};
+  const std::string content{std::istreambuf_iterator<char>{i}, {}};
+  std::remove(filename.c_str());
+  return content;
+}
+
+class RExporterTest : public testing::Test {
+protected:
+  RExporterTest() {
+    names_.Register("");
+    names_.Register("Foo");
+  }
+
+  void Export(RExporter &r, const std::vector<Event> &events) {
+    r(0, 0U, Segments<Event>{Segment<Event>{events.data(), events.data() + events.size()}}, names_, TimeBase{});
+  }
+
+  NameTable names_{};
+};
+
+// "RDX2\n", the version header and the terminating nil.
+constexpr std::size_t empty_file_size{5U + 14U + 4U};
+
+TEST_F(RExporterTest, WhenFileExists_ExpectTruncated) {
+  {
+    std::ofstream o{"test.rdata", std::ios::binary};
+    o << std::string(1000U, 'x');
+  }
+  { RExporter r{"test.rdata"}; }
+
+  const std::string content{Read("test.rdata")};
+  EXPECT_EQ(empty_file_size, content.size());
+  EXPECT_EQ(0U, content.find("RDX2\n"));
+}
+
+TEST_F(RExporterTest, WhenMoveAssigned_ExpectPreviousFileWritten) {
+  {
+    RExporter r{"first.rdata"};
+    Export(r, {Event{Phase::complete, 1U, 1000000U, 0}});
+    r = RExporter{"second.rdata"};
+  }
+
+  const std::string first{Read("first.rdata")};
+  EXPECT_EQ(0U, first.find("RDX2\n"));
+  EXPECT_NE(std::string::npos, first.find("Foo"));
+  EXPECT_EQ(empty_file_size, Read("second.rdata").size());
+}
+
+} // namespace
+} // namespace telemetry
+} // namespace jerryct
@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/series_table.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace jerryct {
+namespace telemetry {
+
+namespace {
+
+void AppendEscaped(const string_view value, std::string &out) {
+  for (const char c : value) {
+    switch (c) {
+    case '\\':
+      out.append("\\\\");
+      break;
+    case '"':
+      out.append("\\\"");
+      break;
+    case '\n':
+      out.append("\\n");
+      break;
+    default:
+      out.push_back(c);
+      break;
+    }
+  }
+}
+
+} // namespace
+
+constexpr std::uint32_t SeriesTable::capacity;
+
+std::uint32_t SeriesTable::RegisterFamily(const string_view name, const std::uint32_t cardinality) {
+  std::lock_guard<std::mutex> guard{register_series_};
+
+  for (std::uint32_t i{0U}; i < families_.size(); ++i) {
+    if (families_[i]->name == name) {
+      return i;
+    }
+  }
+
+  families_.emplace_back(new Family{std::string{name.data(), name.size()}, cardinality, 0U,
+                                    std::numeric_limits<std::uint32_t>::max()});
+  return static_cast<std::uint32_t>(families_.size() - 1U);
+}
+
+std::uint32_t SeriesTable::Register(const std::uint32_t family, const std::initializer_list<Label> labels) {
+  std::string rendered{};
+  for (const Label &l : labels) {
+    if (!rendered.empty()) {
+      rendered.push_back(',');
+    }
+    rendered.append(l.first.data(), l.first.size());
+    rendered.append("=\"");
+    AppendEscaped(l.second, rendered);
+    rendered.push_back('"');
+  }
+
+  std::lock_guard<std::mutex> guard{register_series_};
+
+  std::string key{std::to_string(family)};
+  key.push_back('{');
+  key.append(rendered);
+
+  const auto it = ids_.find(key);
+  if (it != ids_.end()) {
+    return it->second;
+  }
+
+  Family &f{*families_[family]};
+  if (f.size == f.cardinality) {
+    if (f.overflow == std::numeric_limits<std::uint32_t>::max()) {
+      f.overflow = Add(family, "overflow=\"true\"");
+    }
+    return f.overflow;
+  }
+
+  const std::uint32_t id{Add(family, std::move(rendered))};
+  ++f.size;
+  ids_.emplace(std::move(key), id);
+  return id;
+}
+
+void SeriesTable::Collect(const std::vector<std::uint64_t> &totals, std::vector<Measurement<LabeledValue>> &values) {
+  std::lock_guard<std::mutex> guard{register_series_};
+
+  if (order_.size() != series_.size()) {
+    order_.resize(series_.size());
+    for (std::uint32_t i{0U}; i < order_.size(); ++i) {
+      order_[i] = i;
+    }
+    std::sort(order_.begin(), order_.end(), [this](const std::uint32_t lhs, const std::uint32_t rhs) {
+      const Series &l{*series_[lhs]};
+      const Series &r{*series_[rhs]};
+      const std::string &l_name{families_[l.family]->name};
+      const std::string &r_name{families_[r.family]->name};
+      return (l_name < r_name) || ((l_name == r_name) && (l.labels < r.labels));
+    });
+  }
+
+  for (const std::uint32_t id : order_) {
+    if (id >= totals.size()) {
+      continue;
+    }
+    const Series &s{*series_[id]};
+    values.push_back(Measurement<LabeledValue>{families_[s.family]->name, LabeledValue{s.labels, totals[id]}});
+  }
+}
+
+std::uint32_t SeriesTable::Add(const std::uint32_t family, std::string labels) {
+  const std::uint32_t id{size_.load(std::memory_order_relaxed)};
+  if (id == capacity) {
+    throw std::length_error{"too many series"};
+  }
+  series_.emplace_back(new Series{family, std::move(labels)});
+  size_.store(id + 1U, std::memory_order_release);
+  return id;
+}
+
+} // namespace telemetry
+} // namespace jerryct
@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: MIT
+
+#ifndef JERRYCT_TELEMETRY_SERIES_TABLE_H
+#define JERRYCT_TELEMETRY_SERIES_TABLE_H
+
+#include "jerryct/string_view.h"
+#include "jerryct/telemetry/measurements.h"
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace jerryct {
+namespace telemetry {
+
+using Label = std::pair<string_view, string_view>;
+
+// Value of one labeled series of a family. labels is rendered as in the OpenMetrics text format, e.g.
+// k1="v1",k2="v2".
+struct LabeledValue {
+  string_view labels;
+  std::uint64_t value;
+};
+
+// Interns label sets of metric families into dense series ids. Each family tracks at most its cardinality of label
+// sets; all further label sets share one series labeled overflow="true", so memory stays bounded.
+class SeriesTable {
+public:
+  static constexpr std::uint32_t capacity{65536U};
+
+  SeriesTable() = default;
+  SeriesTable(const SeriesTable &) = delete;
+  SeriesTable(SeriesTable &&) = delete;
+  SeriesTable &operator=(const SeriesTable &) = delete;
+  SeriesTable &operator=(SeriesTable &&) = delete;
+  ~SeriesTable() noexcept = default;
+
+  // Registering a known name again returns the same family and keeps its cardinality.
+  std::uint32_t RegisterFamily(const string_view name, const std::uint32_t cardinality);
+  // Throws std::length_error when the table holds capacity series.
+  std::uint32_t Register(const std::uint32_t family, const std::initializer_list<Label> labels);
+
+  std::uint32_t Size() const { return size_.load(std::memory_order_acquire); }
+
+  // Appends the series with an id below totals.size() with their value from totals, sorted by family name and labels.
+  void Collect(const std::vector<std::uint64_t> &totals, std::vector<Measurement<LabeledValue>> &values);
+
+private:
+  struct Family {
+    std::string name;
+    std::uint32_t cardinality;
+    std::uint32_t size;
+    std::uint32_t overflow;
+  };
+
+  struct Series {
+    std::uint32_t family;
+    std::string labels;
+  };
+
+  std::uint32_t Add(const std::uint32_t family, std::string labels);
+
+  std::mutex register_series_;
+  std::atomic<std::uint32_t> size_{0U};
+  std::vector<std::unique_ptr<Family>> families_;
+  std::vector<std::unique_ptr<Series>> series_;
+  std::unordered_map<std::string, std::uint32_t> ids_;
+  std::vector<std::uint32_t> order_;
+};
+
+} // namespace telemetry
+} // namespace jerryct
+
+#endif // JERRYCT_TELEMETRY_SERIES_TABLE_H
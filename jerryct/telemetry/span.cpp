@@ -1,19 +1,51 @@
 // SPDX-License-Identifier: MIT
 
 #include "jerryct/telemetry/span.h"
-#include <chrono>
+#include <algorithm>
+#include <limits>
 
 namespace jerryct {
 namespace telemetry {
 
-Span::Span(TracerImpl &t, const jerryct::string_view name) : t_{t.PerThreadEvents()} {
-  const auto now = std::chrono::steady_clock::now();
-  t_->Emplace(Phase::begin, now, name);
+Span::Span(TracerImpl &t, const jerryct::string_view name) : Span{t, t.RegisterName(name)} {}
+
+constexpr std::uint32_t Span::max_args;
+
+Span::Span(TracerImpl &t, const std::uint32_t name) : t_{&t}, e_{nullptr}, name_{name}, args_size_{0U}, start_{0} {
+  if (!t.Sampled(name)) {
+    return;
+  }
+  e_ = t.PerThreadEvents();
+  start_ = t.Now();
+  if (t_->Mode() == EventMode::begin_end) {
+    e_->Emplace(Event{Phase::begin, name_ & 0xFFFFFFU, 0U, start_});
+  }
 }
 
 Span::~Span() noexcept {
-  const auto now = std::chrono::steady_clock::now();
-  t_->Emplace(Phase::end, now, jerryct::string_view{""});
+  if (e_ == nullptr) {
+    return;
+  }
+  // An unsynchronized TSC can go backwards when the thread migrates to another core.
+  const std::int64_t now{std::max(t_->Now(), start_)};
+  const std::int64_t duration{now - start_};
+
+  if (t_->Mode() == EventMode::complete) {
+    if (duration <= std::numeric_limits<std::uint32_t>::max()) {
+      EmplaceArgs();
+      e_->Emplace(Event{Phase::complete, name_ & 0xFFFFFFU, static_cast<std::uint32_t>(duration), start_});
+      return;
+    }
+    e_->Emplace(Event{Phase::begin, name_ & 0xFFFFFFU, 0U, start_});
+  }
+  EmplaceArgs();
+  e_->Emplace(Event{Phase::end, 0U, 0U, now});
+}
+
+void Span::EmplaceArgs() {
+  for (std::uint32_t i{0U}; i < args_size_; ++i) {
+    e_->Emplace(args_[i]);
+  }
 }
 
 } // namespace telemetry
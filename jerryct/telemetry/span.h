@@ -5,21 +5,52 @@
 
 #include "jerryct/string_view.h"
 #include "jerryct/telemetry/tracer.h"
+#include <array>
+#include <cstdint>
 
 namespace jerryct {
 namespace telemetry {
 
+// Records the lifetime of a scope, unless the tracer does not sample its name. A span which is not sampled takes no
+// time stamps; created from a name id it costs a single check.
 class Span final {
 public:
+  static constexpr std::uint32_t max_args{4U};
+
+  // Looks up the name before the check whether it is sampled, i.e. hashes it and probes the name table even if it is
+  // not. Where that matters, register the name once and use the id instead.
   Span(TracerImpl &t, const jerryct::string_view name);
+  // name as returned by TracerImpl::RegisterName(). Costs a single check if not sampled.
+  Span(TracerImpl &t, const std::uint32_t name);
   Span(const Span &) = delete;
   Span(Span &&) = delete;
   Span &operator=(const Span &) = delete;
   Span &operator=(Span &&) = delete;
   ~Span() noexcept;
 
+  // Attaches an integer, floating point or string argument, e.g. a batch size or a shard id. Arguments are kept in the
+  // span and exported with its end. Arguments beyond max_args are dropped.
+  template <typename T> void Arg(const std::uint32_t key, const T &value) {
+    if ((e_ != nullptr) && (args_size_ < max_args)) {
+      args_[args_size_] = MakeArg(key, value);
+      ++args_size_;
+    }
+  }
+  template <typename T> void Arg(const jerryct::string_view key, const T &value) {
+    if (e_ != nullptr) {
+      Arg(t_->RegisterName(key), value);
+    }
+  }
+
 private:
-  TracerImpl::Events *t_;
+  void EmplaceArgs();
+
+  TracerImpl *t_;
+  TracerImpl::Events *e_;
+  std::uint32_t name_;
+  std::uint32_t args_size_;
+  std::int64_t start_;
+  std::array<Event, max_args> args_;
 };
 
 } // namespace telemetry
@@ -15,6 +15,62 @@ void Span(benchmark::State &state) {
   }
 }
 
-BENCHMARK(Span);
+void SpanRegisteredName(benchmark::State &state) {
+  const std::uint32_t name{jerryct::telemetry::Tracer().RegisterName(std::string(64, 'c'))};
+  for (auto _ : state) {
+    jerryct::telemetry::Span s{jerryct::telemetry::Tracer(), name};
+    jerryct::telemetry::Tracer().PerThreadEvents()->ConsumeAll([](auto /*unused*/) {});
+    benchmark::DoNotOptimize(jerryct::telemetry::Tracer().PerThreadEvents());
+    benchmark::ClobberMemory();
+  }
+}
+
+void SpanClock(benchmark::State &state) {
+  jerryct::telemetry::TracerImpl tracer{static_cast<jerryct::telemetry::Clock>(state.range(0))};
+  const std::uint32_t name{tracer.RegisterName(std::string(64, 'c'))};
+  for (auto _ : state) {
+    jerryct::telemetry::Span s{tracer, name};
+    tracer.PerThreadEvents()->ConsumeAll([](auto /*unused*/) {});
+    benchmark::DoNotOptimize(tracer.PerThreadEvents());
+    benchmark::ClobberMemory();
+  }
+}
+
+void SpanSampling(benchmark::State &state) {
+  jerryct::telemetry::TracerImpl tracer{};
+  const std::uint32_t name{tracer.RegisterName(std::string(64, 'c'))};
+  tracer.SetSampling({std::string(64, 'c'), static_cast<double>(state.range(0)) / 100.0});
+  for (auto _ : state) {
+    jerryct::telemetry::Span s{tracer, name};
+    tracer.PerThreadEvents()->ConsumeAll([](auto /*unused*/) {});
+    benchmark::DoNotOptimize(tracer.PerThreadEvents());
+    benchmark::ClobberMemory();
+  }
+}
+
+void SpanArgs(benchmark::State &state) {
+  const std::uint32_t name{jerryct::telemetry::Tracer().RegisterName(std::string(64, 'c'))};
+  const std::uint32_t bytes{jerryct::telemetry::Tracer().RegisterName("bytes")};
+  const std::uint32_t shard{jerryct::telemetry::Tracer().RegisterName("shard")};
+  for (auto _ : state) {
+    jerryct::telemetry::Span s{jerryct::telemetry::Tracer(), name};
+    s.Arg(bytes, std::uint64_t{4096U});
+    s.Arg(shard, "eu-1");
+    jerryct::telemetry::Tracer().PerThreadEvents()->ConsumeAll([](auto /*unused*/) {});
+    benchmark::DoNotOptimize(jerryct::telemetry::Tracer().PerThreadEvents());
+    benchmark::ClobberMemory();
+  }
+}
+
+// Looking up the name of a span does not lock, so threads do not contend.
+BENCHMARK(Span)->Threads(1)->Threads(4);
+BENCHMARK(SpanRegisteredName);
+BENCHMARK(SpanArgs);
+BENCHMARK(SpanClock)
+    ->Arg(static_cast<int>(jerryct::telemetry::Clock::steady))
+    ->Arg(static_cast<int>(jerryct::telemetry::Clock::monotonic_coarse))
+    ->Arg(static_cast<int>(jerryct::telemetry::Clock::tsc));
+// Percentage of spans recorded: enabled, sampled and disabled.
+BENCHMARK(SpanSampling)->Arg(100)->Arg(1)->Arg(0);
 
 } // namespace
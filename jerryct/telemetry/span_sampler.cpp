@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/span_sampler.h"
+#include <cstring>
+#include <functional>
+#include <new>
+#include <thread>
+
+namespace jerryct {
+namespace telemetry {
+
+namespace {
+
+bool Matches(const string_view pattern, const string_view name) {
+  if (!pattern.empty() && (pattern.back() == '*')) {
+    const string_view prefix{pattern.substr(0U, pattern.size() - 1U)};
+    return name.substr(0U, prefix.size()) == prefix;
+  }
+  return pattern == name;
+}
+
+} // namespace
+
+constexpr std::uint32_t SpanSampler::drop_all_;
+
+std::vector<SamplingRule> SamplingFromEnvironment() {
+  std::vector<SamplingRule> rules{};
+  const char *const value{std::getenv("JERRYCT_TELEMETRY_SPANS")};
+  if (value == nullptr) {
+    return rules;
+  }
+
+  string_view rest{value};
+  while (!rest.empty()) {
+    const std::size_t comma{rest.find(',')};
+    const string_view rule{rest.substr(0U, comma)};
+    rest = (comma == string_view::npos) ? string_view{} : rest.substr(comma + 1U);
+
+    const std::size_t equals{rule.find('=')};
+    const string_view pattern{rule.substr(0U, equals)};
+    if (pattern.empty()) {
+      continue;
+    }
+    double rate{1.0};
+    if (equals != string_view::npos) {
+      const std::string text{rule.substr(equals + 1U).to_string()};
+      char *end{nullptr};
+      rate = std::strtod(text.c_str(), &end);
+      if (text.empty() || (*end != '\0')) {
+        continue;
+      }
+    }
+    rules.push_back(SamplingRule{pattern.to_string(), rate});
+  }
+  return rules;
+}
+
+SpanSampler::SpanSampler()
+    : drops_{static_cast<std::atomic<std::uint32_t> *>(std::calloc(NameTable::capacity, sizeof(std::uint32_t)))} {
+  if (drops_ == nullptr) {
+    throw std::bad_alloc{};
+  }
+}
+
+void SpanSampler::Add(const NameTable &names, SamplingRule rule) {
+  std::lock_guard<std::mutex> guard{update_};
+  const std::uint32_t applied{applied_.load(std::memory_order_relaxed)};
+  const std::uint32_t drop{Drop(rule.rate)};
+  for (std::uint32_t i{0U}; i < applied; ++i) {
+    if (Matches(rule.pattern, names.Get(i))) {
+      drops_.get()[i].store(drop, std::memory_order_relaxed);
+    }
+  }
+  rules_.push_back(std::move(rule));
+}
+
+void SpanSampler::Apply(const NameTable &names) {
+  std::lock_guard<std::mutex> guard{update_};
+  const std::uint32_t size{names.Size()};
+  for (std::uint32_t i{applied_.load(std::memory_order_relaxed)}; i < size; ++i) {
+    std::uint32_t drop{0U};
+    for (const SamplingRule &r : rules_) {
+      if (Matches(r.pattern, names.Get(i))) {
+        drop = Drop(r.rate);
+      }
+    }
+    drops_.get()[i].store(drop, std::memory_order_relaxed);
+  }
+  applied_.store(size, std::memory_order_release);
+}
+
+std::uint32_t SpanSampler::Seed() noexcept {
+  const std::size_t hash{std::hash<std::thread::id>{}(std::this_thread::get_id())};
+  const std::uint32_t seed{static_cast<std::uint32_t>(hash ^ (hash >> 32U))};
+  return seed == 0U ? 1U : seed;
+}
+
+std::uint32_t SpanSampler::Drop(const double rate) noexcept {
+  if (!(rate < 1.0)) {
+    return 0U;
+  }
+  if (!(rate > 0.0)) {
+    return drop_all_;
+  }
+  const double drop{(1.0 - rate) * 4294967296.0};
+  if (drop < 1.0) {
+    return 1U;
+  }
+  return drop >= static_cast<double>(drop_all_) ? drop_all_ - 1U : static_cast<std::uint32_t>(drop);
+}
+
+} // namespace telemetry
+} // namespace jerryct
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: MIT
+
+#ifndef JERRYCT_TELEMETRY_SPAN_SAMPLER_H
+#define JERRYCT_TELEMETRY_SPAN_SAMPLER_H
+
+#include "jerryct/string_view.h"
+#include "jerryct/telemetry/name_table.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace jerryct {
+namespace telemetry {
+
+// Keeps spans whose name matches pattern with probability rate: 0 disables them, 1 keeps all. A pattern ending in *
+// matches all names with that prefix, e.g. a category like db.* or * for all names.
+struct SamplingRule {
+  std::string pattern;
+  double rate;
+};
+
+// Reads JERRYCT_TELEMETRY_SPANS, a comma-separated list of pattern=rate, e.g. *=0.01,db.*=1,db.ping=0. A pattern
+// without rate keeps all its spans. Malformed rates are ignored.
+std::vector<SamplingRule> SamplingFromEnvironment();
+
+// Decides per span name id whether a span is recorded. Each id maps to a drop threshold which is 0 unless a rule
+// applies, so the common case of an unfiltered name is a single relaxed load and branch. Rules are matched in order
+// and the last matching rule wins.
+class SpanSampler {
+public:
+  SpanSampler();
+  SpanSampler(const SpanSampler &) = delete;
+  SpanSampler(SpanSampler &&) = delete;
+  SpanSampler &operator=(const SpanSampler &) = delete;
+  SpanSampler &operator=(SpanSampler &&) = delete;
+  ~SpanSampler() noexcept = default;
+
+  bool Sampled(const std::uint32_t name) const noexcept {
+    const std::uint32_t drop{drops_.get()[name].load(std::memory_order_relaxed)};
+    if (drop == 0U) {
+      return true;
+    }
+    return (drop != drop_all_) && (Random() >= drop);
+  }
+
+  // Applies the rules to the names registered since the last call.
+  void Update(const NameTable &names) {
+    if (names.Size() > applied_.load(std::memory_order_acquire)) {
+      Apply(names);
+    }
+  }
+
+  // Adds a rule and applies it to all names registered so far. Can be called at any time.
+  void Add(const NameTable &names, SamplingRule rule);
+
+private:
+  static constexpr std::uint32_t drop_all_{0xFFFFFFFFU};
+
+  struct Free {
+    void operator()(std::atomic<std::uint32_t> *p) const noexcept { std::free(p); }
+  };
+
+  // xorshift32 per thread; its quality is good enough to thin out spans.
+  static std::uint32_t Random() noexcept {
+    thread_local std::uint32_t state{Seed()};
+    state ^= state << 13U;
+    state ^= state >> 17U;
+    state ^= state << 5U;
+    return state;
+  }
+  static std::uint32_t Seed() noexcept;
+
+  static std::uint32_t Drop(const double rate) noexcept;
+  void Apply(const NameTable &names);
+
+  // One threshold per name id. Zeroed memory from calloc is only backed by pages once a rule touches it.
+  const std::unique_ptr<std::atomic<std::uint32_t>, Free> drops_;
+  std::mutex update_;
+  std::atomic<std::uint32_t> applied_{0U};
+  std::vector<SamplingRule> rules_;
+};
+
+} // namespace telemetry
+} // namespace jerryct
+
+#endif // JERRYCT_TELEMETRY_SPAN_SAMPLER_H
@@ -2,7 +2,10 @@
 
 #include "jerryct/telemetry/span.h"
 #include <algorithm>
+#include <cstdlib>
 #include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -10,6 +13,17 @@ namespace jerryct {
 namespace telemetry {
 namespace {
 
+std::vector<std::string> CompletedNames(TracerImpl &tracer) {
+  std::vector<std::string> names{};
+  tracer.Export([&names](const std::int32_t /*unused*/, const std::uint64_t /*unused*/, const Segments<Event> &data,
+                         const NameTable &table, const TimeBase & /*unused*/) {
+    for (const Event &e : data) {
+      names.emplace_back(table.Get(e.name).data(), table.Get(e.name).size());
+    }
+  });
+  return names;
+}
+
 TEST(SpanTest, SingleThread) {
   TracerImpl tracer{};
 
@@ -24,13 +38,14 @@ TEST(SpanTest, SingleThread) {
   t.join();
 
   std::vector<std::tuple<std::string, Phase>> events{};
-  std::vector<std::chrono::steady_clock::time_point> time_stamps{};
+  std::vector<std::int64_t> time_stamps{};
 
   tracer.Export([&events, &time_stamps](const std::int32_t /*unused*/, const std::uint64_t losts,
-                                        const std::vector<Event> &data) {
+                                        const Segments<Event> &data, const NameTable &names,
+                                        const TimeBase & /*unused*/) {
     EXPECT_EQ(0U, losts);
     for (const Event &e : data) {
-      events.emplace_back(std::string{e.name.Get().data(), e.name.Get().size()}, e.phase);
+      events.emplace_back(std::string{names.Get(e.name).data(), names.Get(e.name).size()}, e.phase);
       time_stamps.emplace_back(e.time_stamp);
     }
   });
@@ -60,10 +75,11 @@ TEST(SpanTest, MultiThreaded) {
   std::vector<std::tuple<std::string, Phase>> events{};
   std::vector<std::int32_t> tids{};
 
-  tracer.Export([&events, &tids](const std::int32_t tid, const std::uint64_t losts, const std::vector<Event> &data) {
+  tracer.Export([&events, &tids](const std::int32_t tid, const std::uint64_t losts, const Segments<Event> &data,
+                                  const NameTable &names, const TimeBase & /*unused*/) {
     EXPECT_EQ(0U, losts);
     for (const Event &e : data) {
-      events.emplace_back(std::string{e.name.Get().data(), e.name.Get().size()}, e.phase);
+      events.emplace_back(std::string{names.Get(e.name).data(), names.Get(e.name).size()}, e.phase);
       tids.emplace_back(tid);
     }
   });
@@ -82,6 +98,183 @@ TEST(SpanTest, MultiThreaded) {
   EXPECT_NE(tids[0U], tids[2U]);
 }
 
+TEST(SpanTest, CompleteEvents) {
+  TracerImpl tracer{Clock::steady, EventMode::complete};
+
+  std::thread t{[&tracer]() {
+    Span s1{tracer, "main"};
+    { Span s2{tracer, "foo"}; }
+  }};
+  t.join();
+
+  std::vector<std::tuple<std::string, Phase>> events{};
+  std::vector<std::int64_t> ends{};
+
+  tracer.Export([&events, &ends](const std::int32_t /*unused*/, const std::uint64_t losts,
+                                 const Segments<Event> &data, const NameTable &names,
+                                 const TimeBase & /*unused*/) {
+    EXPECT_EQ(0U, losts);
+    for (const Event &e : data) {
+      events.emplace_back(std::string{names.Get(e.name).data(), names.Get(e.name).size()}, e.phase);
+      ends.emplace_back(e.time_stamp + e.duration);
+    }
+  });
+
+  ASSERT_EQ(2U, events.size());
+
+  EXPECT_EQ(std::make_tuple("foo", Phase::complete), events[0U]);
+  EXPECT_EQ(std::make_tuple("main", Phase::complete), events[1U]);
+
+  EXPECT_LE(ends[0U], ends[1U]);
+}
+
+TEST(SpanTest, RegisteredName) {
+  TracerImpl tracer{};
+  const std::uint32_t name{tracer.RegisterName("main")};
+
+  EXPECT_EQ(name, tracer.RegisterName("main"));
+  EXPECT_NE(name, tracer.RegisterName("foo"));
+
+  std::thread t{[&tracer, name]() {
+    Span s1{tracer, name};
+    Span s2{tracer, "main"};
+  }};
+  t.join();
+
+  std::vector<std::uint32_t> names{};
+
+  tracer.Export([&names](const std::int32_t /*unused*/, const std::uint64_t /*unused*/, const Segments<Event> &data,
+                         const NameTable & /*unused*/, const TimeBase & /*unused*/) {
+    for (const Event &e : data) {
+      names.push_back(e.name);
+    }
+  });
+
+  ASSERT_EQ(4U, names.size());
+
+  EXPECT_EQ(name, names[0U]);
+  EXPECT_EQ(name, names[1U]);
+  EXPECT_EQ(0U, names[2U]);
+  EXPECT_EQ(0U, names[3U]);
+}
+
+TEST(SpanTest, WhenNameOrCategoryDisabled_ExpectNoEvents) {
+  TracerImpl tracer{Clock::steady, EventMode::complete};
+  tracer.SetSampling(SamplingRule{"db.*", 0.0});
+  tracer.SetSampling(SamplingRule{"db.query", 1.0});
+  tracer.SetSampling(SamplingRule{"noise", 0.0});
+
+  std::thread t{[&tracer]() {
+    { Span s{tracer, "db.connect"}; }
+    { Span s{tracer, "db.query"}; }
+    { Span s{tracer, "noise"}; }
+    { Span s{tracer, "main"}; }
+  }};
+  t.join();
+
+  EXPECT_EQ((std::vector<std::string>{"db.query", "main"}), CompletedNames(tracer));
+}
+
+TEST(SpanTest, WhenSamplingChangedAtRuntime_ExpectRegisteredNamesFollow) {
+  TracerImpl tracer{Clock::steady, EventMode::complete};
+  const std::uint32_t name{tracer.RegisterName("main")};
+
+  const auto trace = [&tracer, name]() {
+    std::thread t{[&tracer, name]() { Span s{tracer, name}; }};
+    t.join();
+  };
+
+  trace();
+  tracer.SetSampling(SamplingRule{"*", 0.0});
+  trace();
+  tracer.SetSampling(SamplingRule{"main", 1.0});
+  trace();
+
+  EXPECT_EQ((std::vector<std::string>{"main", "main"}), CompletedNames(tracer));
+}
+
+TEST(SpanTest, WhenSampled_ExpectFractionOfSpans) {
+  TracerImpl tracer{Clock::steady, EventMode::complete, Overflow::drop_newest, 0U, 16384U};
+  tracer.SetSampling(SamplingRule{"main", 0.25});
+
+  std::thread t{[&tracer]() {
+    for (std::int32_t i{0}; i < 10000; ++i) {
+      Span s{tracer, "main"};
+    }
+  }};
+  t.join();
+
+  const std::size_t sampled{CompletedNames(tracer).size()};
+  EXPECT_LT(2000U, sampled);
+  EXPECT_GT(3000U, sampled);
+}
+
+TEST(SpanTest, WhenTracersUsedBySameThread_ExpectEventsPerTracer) {
+  TracerImpl first{Clock::steady, EventMode::complete};
+  TracerImpl second{Clock::steady, EventMode::begin_end};
+  {
+    Span a{first, "a"};
+  }
+  {
+    Span b{second, "b"};
+  }
+
+  EXPECT_EQ((std::vector<std::string>{"a"}), CompletedNames(first));
+  EXPECT_EQ((std::vector<std::string>{"b", ""}), CompletedNames(second));
+}
+
+TEST(SpanTest, WhenCapacityTooLarge_ExpectTracerRejected) {
+  EXPECT_THROW(TracerImpl(Clock::steady, EventMode::begin_end, Overflow::drop_newest, 0U, 0xFFFFFFFFU),
+               std::invalid_argument);
+}
+
+TEST(SpanTest, WhenSpansConfiguredInEnvironment_ExpectSamplingRules) {
+  ::setenv("JERRYCT_TELEMETRY_SPANS", "*=0.01,db.*,db.ping=0,bad=x,=1", 1);
+  const std::vector<SamplingRule> rules{SamplingFromEnvironment()};
+  ::unsetenv("JERRYCT_TELEMETRY_SPANS");
+
+  ASSERT_EQ(3U, rules.size());
+  EXPECT_EQ("*", rules[0U].pattern);
+  EXPECT_DOUBLE_EQ(0.01, rules[0U].rate);
+  EXPECT_EQ("db.*", rules[1U].pattern);
+  EXPECT_DOUBLE_EQ(1.0, rules[1U].rate);
+  EXPECT_EQ("db.ping", rules[2U].pattern);
+  EXPECT_DOUBLE_EQ(0.0, rules[2U].rate);
+}
+
+TEST(SpanTest, WhenArgsAttached_ExpectArgsBeforeEnd) {
+  TracerImpl tracer{};
+
+  std::thread t{[&tracer]() {
+    Span s{tracer, "read"};
+    s.Arg("bytes", std::uint64_t{4096U});
+    s.Arg("offset", -1);
+    s.Arg("ratio", 0.25);
+    s.Arg("shard", "eu-central-1a");
+    s.Arg("dropped", 1);
+    { Span child{tracer, "child"}; }
+  }};
+  t.join();
+
+  std::vector<Event> events{};
+  tracer.Export([&events](const std::int32_t /*unused*/, const std::uint64_t /*unused*/, const Segments<Event> &data,
+                          const NameTable & /*unused*/, const TimeBase & /*unused*/) {
+    events.insert(events.end(), data.begin(), data.end());
+  });
+
+  ASSERT_EQ(8U, events.size());
+  EXPECT_EQ(Phase::arg_uint, events[3U].phase);
+  EXPECT_EQ(4096U, ArgUint(events[3U]));
+  EXPECT_EQ(Phase::arg_int, events[4U].phase);
+  EXPECT_EQ(-1, ArgInt(events[4U]));
+  EXPECT_EQ(Phase::arg_double, events[5U].phase);
+  EXPECT_DOUBLE_EQ(0.25, ArgDouble(events[5U]));
+  EXPECT_EQ(Phase::arg_string, events[6U].phase);
+  char bytes[max_arg_string];
+  EXPECT_EQ("eu-central-1", ArgString(events[6U], bytes));
+  EXPECT_EQ(Phase::end, events[7U].phase);
+}
+
 } // namespace
 } // namespace telemetry
 } // namespace jerryct
@@ -1,50 +1,201 @@
 // SPDX-License-Identifier: MIT
 
 #include "jerryct/telemetry/stats_exporter.h"
+#include <algorithm>
+#include <cmath>
+#include <fmt/format.h>
+#include <iterator>
+#include <limits>
+#include <utility>
 
 namespace jerryct {
 namespace telemetry {
 
+constexpr std::uint32_t HdrBuckets::count;
+constexpr std::uint32_t StatsExporter::no_series;
+
 StatsExporter::~StatsExporter() noexcept { Print(); }
 
-void StatsExporter::operator()(const std::int32_t tid, const std::uint64_t losts, const std::vector<Event> &events) {
+void StatsExporter::operator()(const std::int32_t tid, const std::uint64_t losts, const Segments<Event> &events,
+                               const NameTable &names, const TimeBase &time_base) {
   auto &stack = stacks_[tid];
+  auto &args = args_[tid];
   for (const Event &e : events) {
     switch (e.phase) {
     case Phase::begin:
-      stack.push_back({{e.name.Get().data(), e.name.Get().size()}, e.time_stamp});
+      stack.push_back({e.name, e.time_stamp});
       break;
     case Phase::end:
       if (!stack.empty()) {
-        auto &data = data_[stack.back().name];
-        const auto d = e.time_stamp - stack.back().ts;
-        data.min = d < data.min ? d : data.min;
-        data.max = d > data.max ? d : data.max;
-        data.sum += d;
-        ++data.count;
+        Add(SeriesOf(stack.back().name, args, names), time_base.ToDuration(e.time_stamp - stack.back().ts));
         stack.pop_back();
       }
+      args.clear();
+      break;
+    case Phase::complete:
+      Add(SeriesOf(e.name, args, names), time_base.ToDuration(e.duration));
+      args.clear();
+      break;
+    case Phase::arg_int:
+    case Phase::arg_uint:
+    case Phase::arg_double:
+    case Phase::arg_string:
+      args.push_back(e);
+      break;
+    case Phase::async_begin:
+    case Phase::flow_start:
+      Match(e, false, names, time_base);
+      break;
+    case Phase::async_end:
+    case Phase::flow_end:
+      Match(e, true, names, time_base);
       break;
     }
   }
   losts_[tid] = losts;
 }
 
+void StatsExporter::Match(const Event &e, const bool end, const NameTable &names, const TimeBase &time_base) {
+  const auto it = pending_.find(e.duration);
+  if ((it == pending_.end()) || (it->second.end == end)) {
+    pending_[e.duration] = Pending{end, e.time_stamp, window_};
+    return;
+  }
+  const std::int64_t begin{end ? it->second.ts : e.time_stamp};
+  const std::int64_t finish{end ? e.time_stamp : it->second.ts};
+  Add(SeriesOf(e.name, {}, names), time_base.ToDuration(finish - begin));
+  pending_.erase(it);
+}
+
+void StatsExporter::GroupBy(std::string key) { group_by_.push_back(std::move(key)); }
+
+std::uint32_t StatsExporter::SeriesOf(const std::uint32_t name, const std::vector<Event> &args,
+                                      const NameTable &names) {
+  if (!group_by_.empty() && !args.empty()) {
+    const string_view n{names.Get(name)};
+    group_.assign(n.data(), n.size());
+    for (const std::string &key : group_by_) {
+      for (const Event &a : args) {
+        const string_view arg{names.Get(a.name)};
+        if (arg != string_view{key}) {
+          continue;
+        }
+        group_ += ' ';
+        group_ += key;
+        group_ += '=';
+        switch (a.phase) {
+        case Phase::arg_int: {
+          const fmt::format_int value{ArgInt(a)};
+          group_.append(value.data(), value.size());
+        } break;
+        case Phase::arg_uint: {
+          const fmt::format_int value{ArgUint(a)};
+          group_.append(value.data(), value.size());
+        } break;
+        case Phase::arg_double:
+          fmt::format_to(std::back_inserter(group_), "{}", ArgDouble(a));
+          break;
+        default: {
+          char bytes[max_arg_string];
+          const string_view value{ArgString(a, bytes)};
+          group_.append(value.data(), value.size());
+        } break;
+        }
+        break;
+      }
+    }
+    if (group_.size() != n.size()) {
+      const auto it = by_group_.find(group_);
+      if (it != by_group_.end()) {
+        return it->second;
+      }
+      const std::uint32_t series{NewSeries(group_)};
+      by_group_.emplace(group_, series);
+      return series;
+    }
+  }
+
+  if (name >= by_name_.size()) {
+    by_name_.resize(name + 1U, no_series);
+  }
+  if (by_name_[name] == no_series) {
+    by_name_[name] = NewSeries(names.Get(name));
+  }
+  return by_name_[name];
+}
+
+std::uint32_t StatsExporter::NewSeries(const string_view name) {
+  series_.emplace_back();
+  series_.back().name.assign(name.data(), name.size());
+  series_.back().buckets.resize(HdrBuckets::count);
+  return static_cast<std::uint32_t>(series_.size() - 1U);
+}
+
+void StatsExporter::Add(const std::uint32_t series, const std::chrono::nanoseconds d) {
+  Series &s{series_[series]};
+  s.min = d < s.min ? d : s.min;
+  s.max = d > s.max ? d : s.max;
+  s.sum += d;
+  ++s.count;
+  ++s.buckets[HdrBuckets::Index(static_cast<std::uint64_t>(std::max(d.count(), std::int64_t{0})))];
+}
+
+namespace {
+
+// The upper bound of the bucket holding the value of rank ceil(q * count), clamped to the largest value.
+std::int64_t Percentile(const std::vector<std::uint32_t> &buckets, const std::int64_t count, const double q,
+                        const std::int64_t max) {
+  const auto rank = static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(count)));
+  std::uint64_t cumulative{0U};
+  for (std::uint32_t i{0U}; i < HdrBuckets::count; ++i) {
+    cumulative += buckets[i];
+    if (cumulative >= rank) {
+      const std::uint64_t bound{
+          std::min<std::uint64_t>(HdrBuckets::UpperBound(i), std::numeric_limits<std::int64_t>::max())};
+      return std::min(static_cast<std::int64_t>(bound), max);
+    }
+  }
+  return max;
+}
+
+} // namespace
+
 void StatsExporter::Print() {
-  printf("           min            max           mean   count name\n");
-  for (auto &d : data_) {
-    printf("%11lu ns %11lu ns %11lu ns %7zu %s\n", d.second.min.count(), d.second.max.count(),
-           d.second.sum.count() / d.second.count, d.second.count, d.first.c_str());
+  printf("           min            p50            p90            p99          p99.9            max           mean"
+         "   count name\n");
+  for (Series &s : series_) {
+    if (s.count == 0) {
+      continue;
+    }
+    const std::int64_t max{s.max.count()};
+    printf("%11ld ns %11ld ns %11ld ns %11ld ns %11ld ns %11ld ns %11ld ns %7ld %s\n", s.min.count(),
+           Percentile(s.buckets, s.count, 0.5, max), Percentile(s.buckets, s.count, 0.9, max),
+           Percentile(s.buckets, s.count, 0.99, max), Percentile(s.buckets, s.count, 0.999, max), max,
+           s.sum.count() / s.count, s.count, s.name.c_str());
 
-    d.second.min = std::chrono::nanoseconds::max();
-    d.second.max = {};
+    s.min = std::chrono::nanoseconds::max();
+    s.max = {};
+    s.sum = {};
+    s.count = 0;
+    std::fill(s.buckets.begin(), s.buckets.end(), 0U);
   }
 
   std::int64_t total{};
   for (const auto &l : losts_) {
     total += l.second;
   }
-  printf("                                             %7ld total lost event(s)\n", total);
+  printf("%105s%7ld total lost event(s)\n", "", total);
+
+  for (auto it = pending_.begin(); it != pending_.end();) {
+    if (it->second.window != window_) {
+      ++unmatched_;
+      it = pending_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  ++window_;
+  printf("%105s%7ld total unmatched async or flow event(s)\n", "", unmatched_);
 }
 
 } // namespace telemetry
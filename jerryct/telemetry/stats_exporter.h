@@ -5,6 +5,7 @@
 
 #include "jerryct/telemetry/tracer.h"
 #include <chrono>
+#include <cstdint>
 #include <cstdio>
 #include <string>
 #include <unordered_map>
@@ -13,6 +14,33 @@
 namespace jerryct {
 namespace telemetry {
 
+// HDR-style buckets: values below 32 get a bucket each, every power of two above is split into 32 linear buckets. The
+// relative error is at most 3.2 % over the whole uint64_t range, fine enough for tail percentiles.
+struct HdrBuckets {
+  static constexpr std::uint32_t count{1920U};
+
+  static std::uint32_t Index(const std::uint64_t v) noexcept {
+    if (v < 32U) {
+      return static_cast<std::uint32_t>(v);
+    }
+    const std::uint32_t msb{63U - static_cast<std::uint32_t>(__builtin_clzll(v))};
+    return ((msb - 4U) * 32U) + static_cast<std::uint32_t>((v >> (msb - 5U)) & 31U);
+  }
+
+  // Inclusive upper bound of the values falling into bucket i.
+  static std::uint64_t UpperBound(const std::uint32_t i) noexcept {
+    if (i < 32U) {
+      return i;
+    }
+    const std::uint32_t msb{(i / 32U) + 4U};
+    const std::uint64_t lower{std::uint64_t{32U + (i % 32U)} << (msb - 5U)};
+    return lower + ((std::uint64_t{1U} << (msb - 5U)) - 1U);
+  }
+};
+
+// Durations of spans per name, reported by Print() as min, percentiles, max, mean and count of the window since the
+// previous Print(). Spans are keyed by the id of their name, or by an interned group (see GroupBy()), so that
+// exporting allocates only for a name or group seen for the first time.
 class StatsExporter {
 public:
   StatsExporter() = default;
@@ -22,26 +50,62 @@ public:
   StatsExporter &operator=(StatsExporter &&other) noexcept = default;
   ~StatsExporter() noexcept;
 
-  void operator()(const std::int32_t tid, const std::uint64_t losts, const std::vector<Event> &events);
+  void operator()(const std::int32_t tid, const std::uint64_t losts, const Segments<Event> &events,
+                  const NameTable &names, const TimeBase &time_base);
+
+  // Spans carrying an argument with key are reported per value of the argument, e.g. as "read shard=eu-1".
+  void GroupBy(std::string key);
 
+  // Prints the window since the previous Print() and starts a new one. The begin or end of an async span or flow still
+  // waiting for its counterpart since the previous Print(), e.g. as the counterpart was lost, is dropped and counted as
+  // unmatched.
   void Print();
 
 private:
-  struct Metrics {
+  // Pairs the begin and end of an async span or flow by id. Either may be exported first as they can come from
+  // different threads.
+  void Match(const Event &e, const bool end, const NameTable &names, const TimeBase &time_base);
+  void Add(const std::uint32_t series, const std::chrono::nanoseconds d);
+  // The series of a span given its arguments, created on first use.
+  std::uint32_t SeriesOf(const std::uint32_t name, const std::vector<Event> &args, const NameTable &names);
+  std::uint32_t NewSeries(const string_view name);
+
+  struct Series {
+    std::string name;
     std::chrono::nanoseconds min{std::chrono::nanoseconds::max()};
     std::chrono::nanoseconds max{};
     std::chrono::nanoseconds sum{};
     std::int64_t count{};
+    std::vector<std::uint32_t> buckets;
   };
 
   struct Frame {
-    const std::string name;
-    const std::chrono::steady_clock::time_point ts;
+    const std::uint32_t name;
+    const std::int64_t ts;
+  };
+
+  static constexpr std::uint32_t no_series{0xFFFFFFFFU};
+
+  std::vector<Series> series_;
+  // Series per name id, no_series if not seen yet.
+  std::vector<std::uint32_t> by_name_;
+  std::unordered_map<std::string, std::uint32_t> by_group_;
+
+  struct Pending {
+    bool end;
+    std::int64_t ts;
+    // Print() calls before it arrived.
+    std::uint64_t window;
   };
 
-  std::unordered_map<std::string, Metrics> data_;
   std::unordered_map<int, std::vector<Frame>> stacks_;
+  std::unordered_map<std::uint32_t, Pending> pending_;
+  std::unordered_map<int, std::vector<Event>> args_;
+  std::vector<std::string> group_by_;
+  std::string group_;
   std::unordered_map<int, std::uint64_t> losts_;
+  std::uint64_t window_{0U};
+  std::int64_t unmatched_{0};
 };
 
 } // namespace telemetry
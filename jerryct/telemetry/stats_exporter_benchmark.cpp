@@ -3,6 +3,7 @@
 #include "jerryct/telemetry/span.h"
 #include "jerryct/telemetry/stats_exporter.h"
 #include <benchmark/benchmark.h>
+#include <vector>
 
 namespace {
 
@@ -16,6 +17,31 @@ void ExportStats(benchmark::State &state) {
   }
 }
 
+// Events per second of the hot path: matching begin and end, finding the series and recording into its histogram.
+void ExportStatsEvents(benchmark::State &state) {
+  jerryct::telemetry::NameTable names{};
+  names.Register("");
+  std::vector<std::uint32_t> ids{};
+  for (std::int32_t i{0}; i < 8; ++i) {
+    ids.push_back(names.Register("span " + std::to_string(i)));
+  }
+  std::vector<jerryct::telemetry::Event> events{};
+  for (std::int64_t i{0}; i < 1024; i += 2) {
+    const std::uint32_t name{ids[static_cast<std::size_t>((i / 2) % 8)]};
+    events.push_back(jerryct::telemetry::Event{jerryct::telemetry::Phase::begin, name & 0xFFFFFFU, 0U, 1000 * i});
+    events.push_back(jerryct::telemetry::Event{jerryct::telemetry::Phase::end, 0U, 0U, 1000 * i + 37 * (i % 100)});
+  }
+  const jerryct::telemetry::Segments<jerryct::telemetry::Event> segments{
+      jerryct::telemetry::Segment<jerryct::telemetry::Event>{events.data(), events.data() + events.size()}};
+  jerryct::telemetry::StatsExporter stats{};
+
+  for (auto _ : state) {
+    stats(0, 0U, segments, names, jerryct::telemetry::TimeBase{});
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(events.size()));
+}
+
 BENCHMARK(ExportStats);
+BENCHMARK(ExportStatsEvents);
 
 } // namespace
@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/stats_exporter.h"
+#include <gtest/gtest.h>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace jerryct {
+namespace telemetry {
+namespace {
+
+std::string Print(StatsExporter &stats, const std::vector<Event> &events, const NameTable &names) {
+  stats(0, 0U, Segments<Event>{Segment<Event>{events.data(), events.data() + events.size()}}, names, TimeBase{});
+  testing::internal::CaptureStdout();
+  stats.Print();
+  return testing::internal::GetCapturedStdout();
+}
+
+TEST(HdrBucketsTest, WhenValueRecorded_ExpectItFallsIntoBucketBounds) {
+  const std::vector<std::uint64_t> values{0U, 1U, 31U, 32U, 33U, 63U, 64U, 65U, 1000U, 123456789U,
+                                         std::uint64_t{1U} << 40U, std::numeric_limits<std::uint64_t>::max()};
+  for (const std::uint64_t v : values) {
+    const std::uint32_t i{HdrBuckets::Index(v)};
+    ASSERT_LT(i, HdrBuckets::count);
+    EXPECT_LE(v, HdrBuckets::UpperBound(i));
+    EXPECT_LE(static_cast<double>(HdrBuckets::UpperBound(i) - v), static_cast<double>(v) / 32.0);
+    if (i > 0U) {
+      EXPECT_GT(v, HdrBuckets::UpperBound(i - 1U));
+    }
+  }
+  EXPECT_EQ(std::numeric_limits<std::uint64_t>::max(), HdrBuckets::UpperBound(HdrBuckets::count - 1U));
+}
+
+TEST(StatsExporterTest, WhenPrinted_ExpectPercentiles) {
+  NameTable names{};
+  names.Register("");
+  names.Register("query");
+
+  std::vector<Event> events{};
+  for (std::int32_t i{0}; i < 90; ++i) {
+    events.push_back(Event{Phase::complete, 1U, 10U, 0});
+  }
+  for (std::int32_t i{0}; i < 9; ++i) {
+    events.push_back(Event{Phase::complete, 1U, 20U, 0});
+  }
+  events.push_back(Event{Phase::complete, 1U, 30U, 0});
+
+  StatsExporter stats{};
+  const std::string content{Print(stats, events, names)};
+
+  EXPECT_NE(std::string::npos, content.find("         10 ns          10 ns          10 ns          20 ns "
+                                            "         30 ns          30 ns          11 ns     100 query\n"));
+}
+
+TEST(StatsExporterTest, WhenPrintedAgain_ExpectNewWindow) {
+  NameTable names{};
+  names.Register("");
+  names.Register("query");
+
+  StatsExporter stats{};
+  Print(stats, {Event{Phase::complete, 1U, 1000U, 0}, Event{Phase::complete, 1U, 1000U, 0}}, names);
+  const std::string content{Print(stats, {Event{Phase::complete, 1U, 10U, 0}}, names)};
+
+  EXPECT_NE(std::string::npos, content.find("         10 ns       1 query\n"));
+}
+
+TEST(StatsExporterTest, WhenNoSpansInWindow_ExpectNotReported) {
+  NameTable names{};
+  names.Register("");
+  names.Register("query");
+
+  StatsExporter stats{};
+  Print(stats, {Event{Phase::complete, 1U, 10U, 0}}, names);
+  const std::string content{Print(stats, {}, names)};
+
+  EXPECT_EQ(std::string::npos, content.find("query"));
+}
+
+TEST(StatsExporterTest, WhenGroupedByArg_ExpectSpansPerValue) {
+  NameTable names{};
+  names.Register("");
+  names.Register("read");
+  names.Register("shard");
+
+  StatsExporter stats{};
+  stats.GroupBy("shard");
+  const std::string content{Print(stats,
+                                  {MakeArg(2U, string_view{"a"}), Event{Phase::complete, 1U, 10U, 0},
+                                   MakeArg(2U, string_view{"b"}), Event{Phase::complete, 1U, 20U, 0},
+                                   Event{Phase::begin, 1U, 0U, 0}, MakeArg(2U, string_view{"a"}),
+                                   Event{Phase::end, 0U, 0U, 30}},
+                                  names)};
+
+  EXPECT_NE(std::string::npos, content.find("      2 read shard=a\n"));
+  EXPECT_NE(std::string::npos, content.find("      1 read shard=b\n"));
+}
+
+TEST(StatsExporterTest, WhenAsyncEndExportedFirst_ExpectDuration) {
+  NameTable names{};
+  names.Register("");
+  names.Register("request");
+
+  StatsExporter stats{};
+  const std::vector<Event> end{Event{Phase::async_end, 1U, 7U, 50}};
+  stats(1, 0U, Segments<Event>{Segment<Event>{end.data(), end.data() + end.size()}}, names, TimeBase{});
+  const std::string content{Print(stats, {Event{Phase::async_begin, 1U, 7U, 20}}, names)};
+
+  EXPECT_NE(std::string::npos, content.find("         30 ns       1 request\n"));
+}
+
+TEST(StatsExporterTest, WhenAsyncEndInNextWindow_ExpectDuration) {
+  NameTable names{};
+  names.Register("");
+  names.Register("request");
+
+  StatsExporter stats{};
+  Print(stats, {Event{Phase::async_begin, 1U, 7U, 20}}, names);
+  const std::string content{Print(stats, {Event{Phase::async_end, 1U, 7U, 50}}, names)};
+
+  EXPECT_NE(std::string::npos, content.find("         30 ns       1 request\n"));
+  EXPECT_NE(std::string::npos, content.find("      0 total unmatched async or flow event(s)\n"));
+}
+
+TEST(StatsExporterTest, WhenAsyncEndNeverArrives_ExpectDroppedAfterNextWindow) {
+  NameTable names{};
+  names.Register("");
+  names.Register("request");
+
+  StatsExporter stats{};
+  const std::string first{Print(stats, {Event{Phase::async_begin, 1U, 7U, 20}, Event{Phase::flow_start, 1U, 8U, 20}},
+                                names)};
+  const std::string second{Print(stats, {}, names)};
+  const std::string third{Print(stats, {Event{Phase::async_end, 1U, 7U, 50}}, names)};
+
+  EXPECT_NE(std::string::npos, first.find("      0 total unmatched async or flow event(s)\n"));
+  EXPECT_NE(std::string::npos, second.find("      2 total unmatched async or flow event(s)\n"));
+  EXPECT_EQ(std::string::npos, third.find(" request\n"));
+}
+
+} // namespace
+} // namespace telemetry
+} // namespace jerryct
@@ -3,50 +3,138 @@
 #ifndef JERRYCT_TELEMETRY_THREAD_STORAGE_H
 #define JERRYCT_TELEMETRY_THREAD_STORAGE_H
 
+#include <atomic>
 #include <cstdint>
 #include <forward_list>
+#include <functional>
+#include <iterator>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace jerryct {
 namespace telemetry {
 
+// Ids of ThreadStorage instances. Never reused, so a thread cannot mistake a new instance for a destroyed one which
+// lived at the same address.
+inline std::uint64_t NewThreadStorageId() noexcept {
+  static std::atomic<std::uint64_t> next{1U};
+  return next.fetch_add(1U, std::memory_order_relaxed);
+}
+
+// Per-thread data of each registering thread. When a thread exits, the next Export() drains its data one last time and
+// moves it to a free list; the next registering thread takes it over including its tid. Hence memory use and export
+// time follow the live threads and data like counter values or losts carries over to the new owner.
 template <typename T> class ThreadStorage {
   struct Content {
+    template <typename... Args>
+    explicit Content(const std::int32_t t, Args &&... args) : tid{t}, data{std::forward<Args>(args)...} {}
+
     std::int32_t tid;
+    std::atomic<bool> alive{true};
+    bool retired{false};
     T data;
   };
 
+  // Marks the data of the exiting thread for reclamation. Owns a reference so the data outlives the ThreadStorage.
+  struct Registration {
+    explicit Registration(std::shared_ptr<Content> c) : content{std::move(c)} {}
+    Registration(const Registration &) = delete;
+    Registration(Registration &&) = delete;
+    Registration &operator=(const Registration &) = delete;
+    Registration &operator=(Registration &&) = delete;
+    ~Registration() noexcept { content->alive.store(false, std::memory_order_release); }
+
+    const std::shared_ptr<Content> content;
+  };
+
+  struct Cached {
+    std::uint64_t id;
+    T *data;
+  };
+
 public:
+  // The per-thread data of each registering thread is constructed from a copy of args.
+  template <typename... Args>
+  explicit ThreadStorage(Args... args)
+      : make_content_{[args...](const std::int32_t tid) { return std::make_shared<Content>(tid, args...); }} {}
+
   template <typename F> void Export(F &&func) {
     typename std::forward_list<std::shared_ptr<Content>>::iterator it;
     {
       std::lock_guard<std::mutex> guard{register_thread_};
       it = per_thread_events_.begin();
     }
+    bool any_retired{false};
     for (; it != per_thread_events_.end(); ++it) {
       Content *const c{it->get()};
+      // Checked before the drain so that everything the thread wrote before exiting is exported.
+      const bool exited{!c->alive.load(std::memory_order_acquire)};
       func(c->tid, c->data);
+      if (exited) {
+        c->retired = true;
+        any_retired = true;
+      }
+    }
+
+    if (any_retired) {
+      std::lock_guard<std::mutex> guard{register_thread_};
+      per_thread_events_.remove_if([this](std::shared_ptr<Content> &c) {
+        if (!c->retired) {
+          return false;
+        }
+        free_.push_back(std::move(c));
+        return true;
+      });
     }
   }
 
+  // A thread registers once per instance. The data of the instance used last by the thread is cached, so switching
+  // between instances costs a lookup in the thread's registrations.
   T *PerThreadEvents() {
-    thread_local std::shared_ptr<Content> id{RegisterThread()};
-    return &id->data;
+    thread_local Cached cached{0U, nullptr};
+    if (cached.id != id_) {
+      cached = Cached{id_, Lookup()};
+    }
+    return cached.data;
   }
 
   std::shared_ptr<Content> RegisterThread() {
     std::lock_guard<std::mutex> guard{register_thread_};
-    per_thread_events_.push_front(std::make_unique<Content>());
-    per_thread_events_.front()->tid = thread_count_;
-    ++thread_count_;
+    if (free_.empty()) {
+      per_thread_events_.push_front(make_content_(thread_count_));
+      ++thread_count_;
+    } else {
+      free_.back()->alive.store(true, std::memory_order_relaxed);
+      free_.back()->retired = false;
+      per_thread_events_.push_front(std::move(free_.back()));
+      free_.pop_back();
+    }
     return per_thread_events_.front();
   }
 
 private:
+  T *Lookup() {
+    // Registrations of the calling thread with the ThreadStorage<T> instances, by instance id.
+    thread_local std::unordered_map<std::uint64_t, std::unique_ptr<Registration>> registrations{};
+    auto it = registrations.find(id_);
+    if (it == registrations.end()) {
+      // Only the registration still refers to the data of a destroyed instance.
+      for (auto r = registrations.begin(); r != registrations.end();) {
+        r = (r->second->content.use_count() == 1) ? registrations.erase(r) : std::next(r);
+      }
+      it = registrations.emplace(id_, std::make_unique<Registration>(RegisterThread())).first;
+    }
+    return &it->second->content->data;
+  }
+
+  const std::uint64_t id_{NewThreadStorageId()};
+  const std::function<std::shared_ptr<Content>(std::int32_t)> make_content_;
   std::mutex register_thread_;
   std::int32_t thread_count_{0};
   std::forward_list<std::shared_ptr<Content>> per_thread_events_;
+  std::vector<std::shared_ptr<Content>> free_;
 };
 
 } // namespace telemetry
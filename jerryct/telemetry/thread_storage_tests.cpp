@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/thread_storage.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace jerryct {
+namespace telemetry {
+namespace {
+
+TEST(ThreadStorageTest, WhenThreadExited_ExpectFinalExportAndRecycling) {
+  ThreadStorage<std::int32_t> storage{};
+
+  std::int32_t *first{nullptr};
+  std::thread t1{[&storage, &first]() {
+    first = storage.PerThreadEvents();
+    *first = 42;
+  }};
+  t1.join();
+
+  std::vector<std::int32_t> values{};
+  storage.Export([&values](const std::int32_t /*unused*/, const std::int32_t &v) { values.push_back(v); });
+  ASSERT_EQ(1U, values.size());
+  EXPECT_EQ(42, values[0U]);
+
+  values.clear();
+  storage.Export([&values](const std::int32_t /*unused*/, const std::int32_t &v) { values.push_back(v); });
+  EXPECT_EQ(0U, values.size());
+
+  std::int32_t *second{nullptr};
+  std::thread t2{[&storage, &second]() { second = storage.PerThreadEvents(); }};
+  t2.join();
+
+  EXPECT_EQ(first, second);
+
+  std::vector<std::int32_t> tids{};
+  storage.Export([&tids](const std::int32_t tid, const std::int32_t & /*unused*/) { tids.push_back(tid); });
+  ASSERT_EQ(1U, tids.size());
+  EXPECT_EQ(0, tids[0U]);
+}
+
+TEST(ThreadStorageTest, WhenThreadAlive_ExpectNoRecycling) {
+  ThreadStorage<std::int32_t> storage{};
+
+  std::atomic<bool> registered{false};
+  std::atomic<bool> done{false};
+  std::thread alive{[&storage, &registered, &done]() {
+    *storage.PerThreadEvents() = 1;
+    registered = true;
+    while (!done) {
+      std::this_thread::yield();
+    }
+  }};
+  while (!registered) {
+    std::this_thread::yield();
+  }
+  std::thread exited{[&storage]() { *storage.PerThreadEvents() = 2; }};
+  exited.join();
+
+  std::vector<std::int32_t> values{};
+  storage.Export([&values](const std::int32_t /*unused*/, const std::int32_t &v) { values.push_back(v); });
+  EXPECT_EQ(2U, values.size());
+
+  values.clear();
+  storage.Export([&values](const std::int32_t /*unused*/, const std::int32_t &v) { values.push_back(v); });
+  ASSERT_EQ(1U, values.size());
+  EXPECT_EQ(1, values[0U]);
+
+  done = true;
+  alive.join();
+}
+
+TEST(ThreadStorageTest, WhenInstancesUsedBySameThread_ExpectDataPerInstance) {
+  ThreadStorage<std::int32_t> first{};
+  ThreadStorage<std::int32_t> second{};
+  *first.PerThreadEvents() = 1;
+  *second.PerThreadEvents() = 2;
+  *first.PerThreadEvents() += 10;
+
+  std::vector<std::int32_t> values{};
+  first.Export([&values](const std::int32_t /*unused*/, const std::int32_t &v) { values.push_back(v); });
+  second.Export([&values](const std::int32_t /*unused*/, const std::int32_t &v) { values.push_back(v); });
+  EXPECT_EQ((std::vector<std::int32_t>{11, 2}), values);
+}
+
+TEST(ThreadStorageTest, WhenInstanceDestroyed_ExpectNewInstanceStartsAfresh) {
+  {
+    ThreadStorage<std::int32_t> storage{7};
+    *storage.PerThreadEvents() = 1;
+  }
+  ThreadStorage<std::int32_t> storage{7};
+
+  EXPECT_EQ(7, *storage.PerThreadEvents());
+}
+
+} // namespace
+} // namespace telemetry
+} // namespace jerryct
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/tracer.h"
+#include <cstdlib>
+#include <cstring>
+
+namespace jerryct {
+namespace telemetry {
+
+EventMode EventModeFromEnvironment() {
+  const char *const value{std::getenv("JERRYCT_TELEMETRY_EVENTS")};
+  if ((value != nullptr) && (std::strcmp(value, "complete") == 0)) {
+    return EventMode::complete;
+  }
+  return EventMode::begin_end;
+}
+
+Overflow OverflowFromEnvironment() {
+  const char *const value{std::getenv("JERRYCT_TELEMETRY_OVERFLOW")};
+  if (value == nullptr) {
+    return Overflow::drop_newest;
+  }
+  if (std::strcmp(value, "overwrite_oldest") == 0) {
+    return Overflow::overwrite_oldest;
+  }
+  if (std::strcmp(value, "spill") == 0) {
+    return Overflow::spill;
+  }
+  return Overflow::drop_newest;
+}
+
+std::uint32_t CapacityFromEnvironment() {
+  const char *const value{std::getenv("JERRYCT_TELEMETRY_CAPACITY")};
+  if (value == nullptr) {
+    return 4096U;
+  }
+  const unsigned long capacity{std::strtoul(value, nullptr, 10)};
+  if ((capacity == 0U) || (capacity > (1UL << 30U))) {
+    return 4096U;
+  }
+  return static_cast<std::uint32_t>(capacity);
+}
+
+} // namespace telemetry
+} // namespace jerryct
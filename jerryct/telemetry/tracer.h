@@ -3,47 +3,186 @@
 #ifndef JERRYCT_TELEMETRY_TRACER_H
 #define JERRYCT_TELEMETRY_TRACER_H
 
-#include "jerryct/telemetry/fixed_string.h"
+#include "jerryct/string_view.h"
+#include "jerryct/telemetry/clock.h"
 #include "jerryct/telemetry/lock_free_queue.h"
+#include "jerryct/telemetry/name_table.h"
+#include "jerryct/telemetry/span_sampler.h"
 #include "jerryct/telemetry/thread_storage.h"
-#include <chrono>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
-#include <vector>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 namespace jerryct {
 namespace telemetry {
 
-enum class Phase : std::int32_t { begin, end };
+// async_* and flow_* are matched by id instead of by thread, see AsyncSpan and Flow. arg_* are arguments of the next
+// end or complete event of the same thread, see MakeArg().
+enum class Phase : std::uint8_t {
+  begin,
+  end,
+  complete,
+  async_begin,
+  async_end,
+  flow_start,
+  flow_end,
+  arg_int,
+  arg_uint,
+  arg_double,
+  arg_string
+};
 
+// Packed into 16 bytes: name ids are limited to 24 bits. duration is only used by Phase::complete and is given in
+// clock ticks like time_stamp. The async and flow phases carry their id in duration instead.
 struct Event {
-  Phase phase;
-  std::chrono::steady_clock::time_point time_stamp;
-  FixedString<64> name;
+  Phase phase : 8;
+  std::uint32_t name : 24;
+  std::uint32_t duration;
+  std::int64_t time_stamp;
 };
+static_assert(sizeof(Event) == 16U, "");
+
+// Longer strings are truncated when stored in an argument.
+constexpr std::size_t max_arg_string{12U};
+
+// An argument event carries the id of its key as name and its value in place of duration and time_stamp.
+template <typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+Event MakeArg(const std::uint32_t key, const T value) noexcept {
+  if (std::is_signed<T>::value) {
+    return Event{Phase::arg_int, key & 0xFFFFFFU, 0U, static_cast<std::int64_t>(value)};
+  }
+  return Event{Phase::arg_uint, key & 0xFFFFFFU, 0U, static_cast<std::int64_t>(value)};
+}
+
+inline Event MakeArg(const std::uint32_t key, const double value) noexcept {
+  std::int64_t bits{};
+  std::memcpy(&bits, &value, sizeof(bits));
+  return Event{Phase::arg_double, key & 0xFFFFFFU, 0U, bits};
+}
+
+inline Event MakeArg(const std::uint32_t key, const string_view value) noexcept {
+  char bytes[max_arg_string]{};
+  std::memcpy(bytes, value.data(), std::min(value.size(), max_arg_string));
+  std::uint32_t head{};
+  std::int64_t tail{};
+  std::memcpy(&head, bytes, sizeof(head));
+  std::memcpy(&tail, bytes + sizeof(head), sizeof(tail));
+  return Event{Phase::arg_string, key & 0xFFFFFFU, head, tail};
+}
+
+// Argument events carry no time stamp.
+inline bool IsArg(const Event &e) noexcept { return e.phase >= Phase::arg_int; }
+
+inline std::int64_t ArgInt(const Event &e) noexcept { return e.time_stamp; }
+inline std::uint64_t ArgUint(const Event &e) noexcept { return static_cast<std::uint64_t>(e.time_stamp); }
+inline double ArgDouble(const Event &e) noexcept {
+  double value{};
+  std::memcpy(&value, &e.time_stamp, sizeof(value));
+  return value;
+}
+// The returned string refers to bytes.
+inline string_view ArgString(const Event &e, char (&bytes)[max_arg_string]) noexcept {
+  const std::uint32_t head{e.duration};
+  std::memcpy(bytes, &head, sizeof(head));
+  std::memcpy(bytes + sizeof(head), &e.time_stamp, sizeof(e.time_stamp));
+  std::size_t size{0U};
+  while ((size < max_arg_string) && (bytes[size] != '\0')) {
+    ++size;
+  }
+  return {bytes, size};
+}
+
+// begin_end emits a begin and an end event per span. complete emits a single Phase::complete event when the span ends;
+// spans too long for Event::duration fall back to a begin and an end event.
+enum class EventMode : std::int32_t { begin_end, complete };
+
+// Reads JERRYCT_TELEMETRY_EVENTS (begin_end or complete); begin_end if unset or unknown.
+EventMode EventModeFromEnvironment();
+
+// Reads JERRYCT_TELEMETRY_OVERFLOW (drop_newest, overwrite_oldest or spill); drop_newest if unset or unknown.
+Overflow OverflowFromEnvironment();
+
+// Reads JERRYCT_TELEMETRY_CAPACITY (events per thread); 4096 if unset or not a positive number.
+std::uint32_t CapacityFromEnvironment();
 
 class TracerImpl {
 public:
-  using Events = LockFreeQueue<Event, 4096>;
+  using Events = LockFreeQueue<Event>;
 
-  template <typename F> void Export(F &&func) {
-    std::vector<Event> v{};
-    v.reserve(4096U);
+  // capacity, overflow and spill_budget apply to the per-thread event queues, see LockFreeQueue. Throws
+  // std::invalid_argument if capacity exceeds Events::max_capacity, as the queues are only created on first use.
+  explicit TracerImpl(const Clock clock = Clock::steady, const EventMode mode = EventMode::begin_end,
+                      const Overflow overflow = Overflow::drop_newest, const std::size_t spill_budget = 1024U * 1024U,
+                      const std::uint32_t capacity = 4096U)
+      : clock_{clock}, mode_{mode}, time_base_{TimeBase::Calibrate(clock)},
+        storage_{capacity, overflow, spill_budget} {
+    if (capacity > Events::max_capacity) {
+      throw std::invalid_argument{"queue capacity too large"};
+    }
+    RegisterName("");
+  }
 
-    storage_.Export([&v, &func](const std::int32_t tid, Events &e) {
-      v.clear();
-      e.ConsumeAll([&v](const Event &e) { v.push_back(e); });
-      func(tid, e.Losts(), static_cast<const std::vector<Event> &>(v));
+  // Calls func(tid, losts, events, names, time_base) per thread. events refer to the queue in place and are released
+  // once func returns.
+  template <typename F> void Export(F &&func) {
+    storage_.Export([this, &func](const std::int32_t tid, Events &e) {
+      e.Drain([this, tid, &e, &func](const Segments<Event> &events) {
+        func(tid, e.Losts(), events, static_cast<const NameTable &>(names_), static_cast<const TimeBase &>(time_base_));
+      });
     });
   }
 
   Events *PerThreadEvents() { return storage_.PerThreadEvents(); }
 
+  std::int64_t Now() const noexcept { return telemetry::Now(clock_); }
+  EventMode Mode() const noexcept { return mode_; }
+
+  // Names are interned once; events only carry the returned id. Id 0 is the empty name used by end events. Looking up
+  // a name registered before does not lock.
+  std::uint32_t RegisterName(const string_view name) {
+    std::uint32_t id{names_.Find(name)};
+    if (id == NameTable::not_found) {
+      id = names_.Register(name);
+      sampler_.Update(names_);
+    }
+    return id;
+  }
+
+  // Ids of async spans and flows, unique per tracer until they wrap around. Never 0.
+  std::uint32_t NewId() noexcept {
+    const std::uint32_t id{next_id_.fetch_add(1U, std::memory_order_relaxed)};
+    return id == 0U ? next_id_.fetch_add(1U, std::memory_order_relaxed) : id;
+  }
+
+  // Whether a span of name is recorded, see SpanSampler.
+  bool Sampled(const std::uint32_t name) const noexcept { return sampler_.Sampled(name); }
+  // Takes effect for spans started afterwards, including spans of already registered names.
+  void SetSampling(SamplingRule rule) { sampler_.Add(names_, std::move(rule)); }
+
 private:
+  const Clock clock_;
+  const EventMode mode_;
+  const TimeBase time_base_;
+  NameTable names_;
+  SpanSampler sampler_;
+  std::atomic<std::uint32_t> next_id_{1U};
   ThreadStorage<Events> storage_;
 };
 
 inline TracerImpl &Tracer() {
-  static TracerImpl *const t = new TracerImpl;
+  static TracerImpl *const t = []() {
+    TracerImpl *const tracer{new TracerImpl{ClockFromEnvironment(), EventModeFromEnvironment(),
+                                            OverflowFromEnvironment(), 1024U * 1024U, CapacityFromEnvironment()}};
+    for (SamplingRule &r : SamplingFromEnvironment()) {
+      tracer->SetSampling(std::move(r));
+    }
+    return tracer;
+  }();
   return *t;
 }
 
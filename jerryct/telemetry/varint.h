@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: MIT
+
+#ifndef JERRYCT_TELEMETRY_VARINT_H
+#define JERRYCT_TELEMETRY_VARINT_H
+
+#include <cstdint>
+#include <vector>
+
+namespace jerryct {
+namespace telemetry {
+
+// LEB128 as used by protobuf: 7 bits per byte, least significant group first.
+inline void PutVarint(std::uint64_t v, std::vector<std::uint8_t> &buf) {
+  while (v >= 0x80U) {
+    buf.push_back(static_cast<std::uint8_t>(v | 0x80U));
+    v >>= 7U;
+  }
+  buf.push_back(static_cast<std::uint8_t>(v));
+}
+
+// Maps small negative and positive values onto small varints.
+inline void PutZigzag(const std::int64_t v, std::vector<std::uint8_t> &buf) {
+  PutVarint((static_cast<std::uint64_t>(v) << 1U) ^ static_cast<std::uint64_t>(v >> 63), buf);
+}
+
+} // namespace telemetry
+} // namespace jerryct
+
+#endif // JERRYCT_TELEMETRY_VARINT_H
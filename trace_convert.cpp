@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: MIT
+
+#include "jerryct/telemetry/binary_trace.h"
+#include "jerryct/telemetry/call_tree_exporter.h"
+#include "jerryct/telemetry/chrome_trace_event_exporter.h"
+#include "jerryct/telemetry/folded_stack_exporter.h"
+#include "jerryct/telemetry/perfetto_exporter.h"
+#include "jerryct/telemetry/stats_exporter.h"
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+// Converts a trace written by BinaryTraceExporter offline.
+int main(int argc, char **argv) {
+  const bool chrome{(argc == 4) && (std::strcmp(argv[2], "chrome") == 0)};
+  const bool folded{(argc == 4) && (std::strcmp(argv[2], "folded") == 0)};
+  const bool perfetto{(argc == 4) && (std::strcmp(argv[2], "perfetto") == 0)};
+  const bool stats{(argc == 3) && (std::strcmp(argv[2], "stats") == 0)};
+  const bool tree{(argc == 3) && (std::strcmp(argv[2], "tree") == 0)};
+  if (!chrome && !folded && !perfetto && !stats && !tree) {
+    std::fprintf(stderr,
+                 "usage: %s <trace.bin> chrome <trace.json>\n       %s <trace.bin> folded <stacks.txt>\n"
+                 "       %s <trace.bin> perfetto <trace.pftrace>\n       %s <trace.bin> stats\n"
+                 "       %s <trace.bin> tree\n",
+                 argv[0], argv[0], argv[0], argv[0], argv[0]);
+    return 2;
+  }
+
+  try {
+    jerryct::telemetry::BinaryTraceReader reader{argv[1]};
+    if (chrome) {
+      jerryct::telemetry::ChromeTraceEventExporter exporter{argv[3]};
+      reader.Replay(exporter);
+    } else if (folded) {
+      jerryct::telemetry::FoldedStackExporter exporter{argv[3]};
+      reader.Replay(exporter);
+    } else if (perfetto) {
+      jerryct::telemetry::PerfettoExporter exporter{argv[3]};
+      reader.Replay(exporter);
+    } else if (tree) {
+      jerryct::telemetry::CallTreeExporter exporter{};
+      reader.Replay(exporter);
+    } else {
+      jerryct::telemetry::StatsExporter exporter{};
+      reader.Replay(exporter);
+    }
+  } catch (const std::exception &e) {
+    std::fprintf(stderr, "%s: %s\n", argv[0], e.what());
+    return 1;
+  }
+
+  return 0;
+}